@@ -1,4 +1,6 @@
 @rem supports Clang and MSVC
+@rem usage: build.cmd [debug|bench|test]; bench and test build every program in
+@rem src\bench or src\test into build\ and run it
 @echo off
 setlocal
 
@@ -12,7 +14,9 @@ where /q "clang" && (
 )
 
 if "%CC%" == "clang" (
-    set "FLAGS=-o mvn.exe -std=c99 -Wall -Wextra -Wpedantic"
+    set "OUT=-o "
+    set "FLAGS=-std=c99 -Wall -Wextra -Wpedantic"
+    set "WFLAGS=-Wno-unused-function"
     set "LFLAGS=-lmsvcrt -ladvapi32 -lonecore -nostdlib -Wl,/NODEFAULTLIB:libcmt,/INCLUDE:PROGRAM_NAME"
     if "%~1" == "debug" (
         set "DFLAGS=-O0 -g -gcodeview"
@@ -20,8 +24,10 @@ if "%CC%" == "clang" (
         set "DFLAGS=-Os -DNDEBUG"
     )
 ) else if "%CC%" == "cl" (
+    set "OUT=/Fe:"
     set "FLAGS=/W3"
-    set "LFLAGS=msvcrt.lib advapi32.lib onecore.lib /link /NODEFAULTLIB:libcmt /INCLUDE:PROGRAM_NAME /out:mvn.exe"
+    set "WFLAGS="
+    set "LFLAGS=msvcrt.lib advapi32.lib onecore.lib /link /NODEFAULTLIB:libcmt /INCLUDE:PROGRAM_NAME"
     if "%~1" == "debug" (
         set "DFLAGS=/Od /Zi"
     ) else (
@@ -29,9 +35,27 @@ if "%CC%" == "clang" (
     )
 )
 
+if "%~1" == "bench" goto programs
+if "%~1" == "test" goto programs
+
 @echo on
-%CC% src\mvn.c %FLAGS% %DFLAGS% %LFLAGS%
+%CC% src\mvn.c %OUT%mvn.exe %FLAGS% %DFLAGS% %LFLAGS%
 @echo off
+goto exit
+
+@rem the programs pull in all of base and platform but only use some of it
+:programs
+if not exist build mkdir build
+for %%f in (src\%~1\%~1_*.c) do (
+    echo %CC% %%f %OUT%build\%%~nf.exe %FLAGS% %WFLAGS% %DFLAGS% %LFLAGS%
+    %CC% %%f %OUT%build\%%~nf.exe %FLAGS% %WFLAGS% %DFLAGS% %LFLAGS% || goto fail
+    build\%%~nf.exe || goto fail
+)
+goto exit
+
+:fail
+endlocal
+exit /b 1
 
 :exit
 endlocal
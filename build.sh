@@ -1,5 +1,7 @@
 #!/bin/sh
 # supports Clang and GCC
+# usage: build.sh [debug|bench|test]; bench and test build every program in
+# src/bench or src/test into build/ and run it
 
 gcc --version > /dev/null 2>&1 && CC="gcc"
 clang --version > /dev/null 2>&1 && CC="clang"
@@ -9,13 +11,25 @@ if [ "$CC" = "" ]; then
     exit 1
 fi
 
-FLAGS="-o mvn -std=c99 -Wall -Wextra -Wpedantic"
-LFLAGS="-D_GNU_SOURCE -Wl,-u,PROGRAM_NAME"
+FLAGS="-std=c99 -Wall -Wextra -Wpedantic"
+LFLAGS="-D_GNU_SOURCE -pthread -Wl,-u,PROGRAM_NAME"
 if [ "$1" = "debug" ]; then
     DFLAGS="-O0 -g -ggdb"
 else
     DFLAGS="-Os -DNDEBUG"
 fi
 
+if [ "$1" = "bench" ] || [ "$1" = "test" ]; then
+    # the programs pull in all of base and platform but only use some of it
+    mkdir -p build
+    for src in src/$1/$1_*.c; do
+        out="build/$(basename "$src" .c)"
+        (set -x; $CC "$src" -o "$out" $FLAGS -Wno-unused-function $DFLAGS $LFLAGS) || exit 1
+        "./$out" || exit 1
+    done
+
+    exit 0
+fi
+
 set -x
-$CC src/mvn.c $FLAGS $DFLAGS $LFLAGS || exit 1
+$CC src/mvn.c -o mvn $FLAGS $DFLAGS $LFLAGS || exit 1
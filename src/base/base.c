@@ -1,6 +1,12 @@
 #include "base_core.c"
+#include "base_cpu.c"
 #include "base_assert.c"
 #include "base_arena.c"
 #include "base_string.c"
+#include "base_hash.c"
+#include "base_matcher.c"
+#include "base_map.c"
+#include "base_xml.c"
 #include "base_log.c"
+#include "base_trace.c"
 #include "base_command_line.c"
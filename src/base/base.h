@@ -3,10 +3,16 @@
 
 #include "base_context_cracking.h"
 #include "base_core.h"
+#include "base_cpu.h"
 #include "base_assert.h"
 #include "base_arena.h"
 #include "base_string.h"
+#include "base_hash.h"
+#include "base_matcher.h"
+#include "base_map.h"
+#include "base_xml.h"
 #include "base_log.h"
+#include "base_trace.h"
 #include "base_command_line.h"
 
 #endif // BASE_H
@@ -1,72 +1,535 @@
-Arena arena_init(usize reserve_factor, usize commit)
+internal inline u32 arena_mem_flags(u32 flags)
+{
+    u32 mem_flags = 0;
+    if (flags & ARENA_HUGE_PAGES) {
+        mem_flags |= PLATFORM_MEM_HUGE_PAGES;
+    }
+
+    if (flags & ARENA_NO_RESERVE) {
+        mem_flags |= PLATFORM_MEM_NO_RESERVE;
+    }
+
+    return mem_flags;
+}
+
+Arena arena_init(usize reserve_factor, usize commit, u32 flags)
 {
     usize page_size = PLATFORM_PAGE_SIZE;
+    usize block_size = align_forward_size(commit, page_size);
     usize reserved = align_forward_size(reserve_factor * commit, page_size);
-    usize committed = align_forward_size(commit, page_size);
-    void *memory = platform_mem_reserve(NULL, reserved);
-    if (memory == NULL) {
+    usize committed = block_size;
+    void *memory = platform_mem_reserve(NULL, reserved, arena_mem_flags(flags));
+    if (memory == NULL || platform_mem_commit(memory, committed) == NULL) {
+        if (memory != NULL) {
+            platform_mem_release(memory, reserved);
+        }
+
+        memory = NULL;
         reserved = 0;
         committed = 0;
-    } else {
-        platform_mem_commit(memory, committed);
     }
 
     return (Arena){
         .reserved = reserved,
         .committed = committed,
-        .block_size = committed,
+        .block_size = block_size,
         .memory = memory,
+        .reserve_size = reserved,
+        .flags = flags,
     };
 }
 
-inline void arena_release(Arena *arena)
+// NOTE(cya): the header lives in the block going away, so it's read first.
+// Pool chunks can't go back to the pool, so the child keeps them (committed
+// pages and all) for its next grows instead
+internal void arena_block_release(Arena *arena)
 {
-    platform_mem_release(arena->memory, arena->reserved);
+    ArenaBlock block = *arena->prev;
+    if (arena->pool == NULL) {
+        platform_mem_release(arena->memory, arena->reserved);
+    } else {
+        ArenaBlock *spare = arena->memory;
+        *spare = (ArenaBlock){
+            .prev = arena->spare,
+            .memory = arena->memory,
+            .reserved = arena->reserved,
+            .committed = arena->committed,
+        };
+        arena->spare = spare;
+    }
+
+    arena->memory = block.memory;
+    arena->reserved = block.reserved;
+    arena->committed = block.committed;
+    arena->base = block.base;
+    arena->prev = block.prev;
+}
+
+void arena_release(Arena *arena)
+{
+    while (arena->prev != NULL) {
+        arena_block_release(arena);
+    }
+
+    b32 is_owned = arena->pool == NULL && !(arena->flags & ARENA_FIXED);
+    if (arena->memory != NULL && is_owned) {
+        platform_mem_release(arena->memory, arena->reserved);
+    }
 }
 
-void *arena_push(Arena *arena, usize size)
+ArenaPool arena_pool_init(usize reserve, usize chunk_size, u32 flags)
+{
+    usize page_size = PLATFORM_PAGE_SIZE;
+    usize reserved = align_forward_size(reserve, page_size);
+    void *memory = platform_mem_reserve(NULL, reserved, arena_mem_flags(flags));
+    return (ArenaPool){
+        .memory = memory,
+        .reserved = memory == NULL ? 0 : reserved,
+        .chunk_size = align_forward_size(chunk_size, page_size),
+        .flags = flags,
+    };
+}
+
+// NOTE(cya): every child is invalid afterwards
+inline void arena_pool_release(ArenaPool *pool)
+{
+    if (pool->memory != NULL) {
+        platform_mem_release(pool->memory, pool->reserved);
+    }
+}
+
+// NOTE(cya): empty until its first push claims a chunk, so children of
+// threads that end up idle cost nothing. Popping a block keeps it on the
+// child for reuse, so a child that keeps pushing and popping (even back to
+// 0) stays within the chunks it already claimed
+inline Arena arena_pool_child(ArenaPool *pool)
+{
+    return (Arena){
+        .block_size = min(kibibytes(64), pool->chunk_size),
+        .reserve_size = pool->chunk_size,
+        .pool = pool,
+    };
+}
+
+// NOTE(cya): the one point of contention; `size` is page aligned, so every
+// chunk can be committed by its owner alone
+internal void *arena_pool_claim(ArenaPool *pool, usize size)
+{
+    u64 offset = atomic_add_u64(&pool->next, size);
+    if (offset + size > pool->reserved) {
+        return NULL;
+    }
+
+    return (void*)((uptr)pool->memory + (uptr)offset);
+}
+
+// NOTE(cya): first fit among the blocks the child popped earlier
+internal ArenaBlock *arena_spare_take(Arena *arena, usize size)
+{
+    for (ArenaBlock **link = &arena->spare; *link != NULL; link = &(*link)->prev) {
+        ArenaBlock *spare = *link;
+        if (spare->reserved >= size) {
+            *link = spare->prev;
+            return spare;
+        }
+    }
+
+    return NULL;
+}
+
+// NOTE(cya): blocks are at least `reserve_size`, bigger only for pushes that
+// wouldn't fit one
+internal b32 arena_grow(Arena *arena, usize size)
+{
+    if (arena->flags & ARENA_FIXED) {
+        assert_msg(false, "fixed arena out of space");
+        return false;
+    }
+
+    // NOTE(cya): blocks are page aligned, so pushes right after the header
+    // need no padding
+    usize header_size = align_forward_size(sizeof(ArenaBlock), DEFAULT_ALIGN);
+    usize page_size = PLATFORM_PAGE_SIZE;
+    usize block_size = max(arena->block_size, page_size);
+    usize reserved = align_forward_size(max(arena->reserve_size, header_size + size), page_size);
+    usize committed = min(block_size, reserved);
+    usize spare_committed = 0;
+    void *memory;
+    ArenaBlock *spare = arena->pool != NULL ? arena_spare_take(arena, reserved) : NULL;
+    if (spare != NULL) {
+        memory = spare;
+        reserved = spare->reserved;
+        spare_committed = spare->committed;
+    } else if (arena->pool != NULL) {
+        memory = arena_pool_claim(arena->pool, reserved);
+    } else {
+        memory = platform_mem_reserve(NULL, reserved, arena_mem_flags(arena->flags));
+    }
+
+    b32 needs_commit = committed > spare_committed;
+    if (memory == NULL || (needs_commit && platform_mem_commit(memory, committed) == NULL)) {
+        if (memory != NULL && arena->pool == NULL) {
+            platform_mem_release(memory, reserved);
+        }
+
+        assert_fatal("unable to grow arena by {size}", (u64)reserved);
+        return false;
+    }
+
+    committed = max(committed, spare_committed);
+    if (arena->stats != NULL) {
+        arena->stats->blocks += 1;
+        arena->stats->commits += needs_commit;
+        arena->stats->commit_bytes += needs_commit ? committed - spare_committed : 0;
+    }
+
+    ArenaBlock *block = memory;
+    *block = (ArenaBlock){
+        .prev = arena->prev,
+        .memory = arena->memory,
+        .reserved = arena->reserved,
+        .committed = arena->committed,
+        .base = arena->base,
+    };
+
+    arena->prev = block;
+    arena->base += arena->offset;
+    arena->memory = memory;
+    arena->reserved = reserved;
+    arena->committed = committed;
+    arena->block_size = block_size;
+    arena->offset = header_size;
+    return true;
+}
+
+// NOTE(cya): sites are string literals, so their addresses are the keys
+internal void arena_stats_record(ArenaStats *stats, usize size, const char *site)
+{
+    stats->tags[stats->tag].bytes += size;
+    stats->tags[stats->tag].count += 1;
+#if defined(BUILD_DEBUG)
+    if (site == NULL) {
+        return;
+    }
+
+    usize mask = ARENA_STATS_MAX_SITES - 1;
+    usize slot = (usize)(((u64)(uptr)site * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+    for (usize probe = 0; probe < ARENA_STATS_MAX_SITES; probe++) {
+        ArenaStatsEntry *entry = &stats->sites[(slot + probe) & mask];
+        if (entry->name == NULL) {
+            entry->name = site;
+            stats->site_count += 1;
+        }
+
+        if (entry->name == site) {
+            entry->bytes += size;
+            entry->count += 1;
+            return;
+        }
+    }
+
+    stats->site_misses += 1;
+#else
+    unused(site);
+#endif
+}
+
+void *__arena_push(Arena *arena, usize size, const char *site)
 {
     uptr memory = (uptr)arena->memory;
-    uptr cur_addr = memory + (uptr)arena->offset;
-    uptr base_addr = align_forward(cur_addr, DEFAULT_ALIGN);
+    uptr base_addr = align_forward(memory + (uptr)arena->offset, DEFAULT_ALIGN);
     usize base_offset = (usize)(base_addr - memory);
-    if (base_addr > memory + (uptr)arena->reserved) {
-        // NOTE(cya): scratch behavior
-        base_addr = align_forward(memory, DEFAULT_ALIGN);
-        base_offset = (usize)(base_addr - memory);
-    } else {
-        usize committed = arena->committed;
-        if (base_offset + size > committed) {
-            // TODO(cya): can we really be sure this will stay in-bounds?
-            usize commit = align_forward(size, arena->block_size);
-            void *commit_addr = (void*)(memory + (uptr)committed);
-            platform_mem_commit(commit_addr, commit);
-            arena->committed += commit;
+    if (base_offset > arena->reserved || size > arena->reserved - base_offset) {
+        if (!arena_grow(arena, size)) {
+            return NULL;
         }
+
+        memory = (uptr)arena->memory;
+        base_addr = align_forward(memory + (uptr)arena->offset, DEFAULT_ALIGN);
+        base_offset = (usize)(base_addr - memory);
     }
 
     usize new_offset = base_offset + size;
+    usize committed = arena->committed;
+    if (new_offset > committed) {
+        usize commit = align_forward_size(new_offset - committed, arena->block_size);
+        commit = min(commit, arena->reserved - committed);
+        if (platform_mem_commit((void*)(memory + (uptr)committed), commit) == NULL) {
+            assert_fatal("unable to commit {size} of arena memory", (u64)commit);
+            return NULL;
+        }
+
+        arena->committed += commit;
+        if (arena->stats != NULL) {
+            arena->stats->commits += 1;
+            arena->stats->commit_bytes += commit;
+        }
+    }
+
     arena->offset = new_offset;
+    if (arena->stats != NULL) {
+        arena->stats->high_water = max(arena->stats->high_water, arena_pos(arena));
+        arena_stats_record(arena->stats, size, site);
+    }
+
     return (void*)base_addr;
 }
 
+inline usize arena_pos(Arena *arena)
+{
+    return arena->base + arena->offset;
+}
+
+// NOTE(cya): blocks entirely past `pos` are released
+void arena_pop_to(Arena *arena, usize pos)
+{
+    while (arena->prev != NULL && pos <= arena->base) {
+        arena_block_release(arena);
+    }
+
+    arena->offset = pos - arena->base;
+}
+
 inline void arena_pop(Arena *arena, usize size)
 {
-    arena->offset -= size;
+    usize pos = arena_pos(arena);
+    arena_pop_to(arena, pos - min(size, pos));
 }
 
+// NOTE(cya): with ARENA_DECOMMIT only the first commit step stays resident
 inline void arena_reset(Arena *arena)
 {
-    arena->offset = 0;
+    arena_pop_to(arena, 0);
+    if ((arena->flags & ARENA_DECOMMIT) && arena->committed > arena->block_size) {
+        uptr memory = (uptr)arena->memory;
+        usize excess = arena->committed - arena->block_size;
+        platform_mem_decommit((void*)(memory + (uptr)arena->block_size), excess);
+        arena->committed = arena->block_size;
+    }
 }
 
-inline void arena_log_stats(Arena *arena)
+inline ArenaTemp arena_temp_begin(Arena *arena)
+{
+    return (ArenaTemp){.arena = arena, .pos = arena_pos(arena)};
+}
+
+inline void arena_temp_end(ArenaTemp temp)
+{
+    arena_pop_to(temp.arena, temp.pos);
+}
+
+thread_local Arena __arena_scratch[ARENA_SCRATCH_COUNT];
+
+// NOTE(cya): per thread and made on first use. `conflicts` are the arenas the
+// caller is still putting results in; the scratch handed out is never one of
+// them, so a function working in scratch can call another that does the same
+ArenaTemp arena_scratch_begin(Arena **conflicts, usize conflict_count)
 {
-    String used = string_from_u64(arena, arena->offset);
-    String committed = string_from_u64(arena, arena->committed);
-    String reserved = string_from_u64(arena, arena->reserved);
-    String usage = string_from_u64(arena, 100 * arena->offset / arena->reserved);
+    Arena *scratch = NULL;
+    for (usize i = 0; i < ARENA_SCRATCH_COUNT && scratch == NULL; i++) {
+        scratch = &__arena_scratch[i];
+        for (usize j = 0; j < conflict_count; j++) {
+            if (conflicts[j] == scratch) {
+                scratch = NULL;
+                break;
+            }
+        }
+    }
 
-    const char *fmt = "memory usage: {}% [used={},committed={},reserved={}]";
-    log_debug(fmt, usage, used, committed, reserved);
+    assert_msg(scratch != NULL, "every scratch arena is in use by the caller");
+    if (scratch->memory == NULL) {
+        *scratch = arena_init(16, kibibytes(64), 0);
+        if (scratch->memory == NULL) {
+            assert_fatal("unable to acquire virtual memory for scratch");
+
+        }
+    }
+
+    return arena_temp_begin(scratch);
+}
+
+inline void arena_scratch_end(ArenaTemp scratch)
+{
+    arena_temp_end(scratch);
+}
+
+// NOTE(cya): for threads that exit before the process does
+void arena_scratch_release(void)
+{
+    for (usize i = 0; i < ARENA_SCRATCH_COUNT; i++) {
+        if (__arena_scratch[i].memory != NULL) {
+            arena_release(&__arena_scratch[i]);
+            __arena_scratch[i] = (Arena){0};
+        }
+    }
+}
+
+typedef struct {
+    usize used;
+    usize committed;
+    usize reserved;
+    u64 blocks;
+} ArenaTotals;
+
+internal ArenaTotals arena_totals(Arena *arena)
+{
+    ArenaTotals totals = {
+        .used = arena_pos(arena),
+        .committed = arena->committed,
+        .reserved = arena->reserved,
+        .blocks = 1,
+    };
+    for (ArenaBlock *block = arena->prev; block != NULL; block = block->prev) {
+        totals.committed += block->committed;
+        totals.reserved += block->reserved;
+        totals.blocks += 1;
+    }
+
+    return totals;
+}
+
+// NOTE(cya): counts from here on, everything before only shows in the high
+// water mark
+inline void arena_stats_attach(Arena *arena, ArenaStats *stats)
+{
+    *stats = (ArenaStats){0};
+    stats->tags[0].name = "untagged";
+    stats->tag_count = 1;
+    stats->high_water = arena_pos(arena);
+    arena->stats = stats;
+}
+
+// NOTE(cya): returns the previous tag to restore later, a no-op without stats
+const char *arena_tag_set(Arena *arena, const char *tag)
+{
+    ArenaStats *stats = arena->stats;
+    if (stats == NULL) {
+        return tag;
+    }
+
+    const char *prev = stats->tags[stats->tag].name;
+    String name = string_from_cstring(tag);
+    u32 i = 0;
+    while (i < stats->tag_count && !string_equals(string_from_cstring(stats->tags[i].name), name)) {
+        i++;
+    }
+
+    if (i == stats->tag_count) {
+        if (i == ARENA_STATS_MAX_TAGS) {
+            i = 0;
+        } else {
+            stats->tags[stats->tag_count++] = (ArenaStatsEntry){.name = tag};
+        }
+    }
+
+    stats->tag = i;
+    return prev;
+}
+
+// NOTE(cya): tags and sites are literals, only paths can carry a backslash
+internal String arena_stats_json_escape(Arena *arena, const char *s)
+{
+    String str = string_from_cstring(s);
+    u8 *buf = arena_push(arena, 2 * str.len);
+    usize len = 0;
+    for (usize i = 0; i < str.len; i++) {
+        if (str.str[i] == '\\' || str.str[i] == '"') {
+            buf[len++] = '\\';
+        }
+
+        buf[len++] = str.str[i];
+    }
+
+    return string_create(buf, len);
+}
+
+internal void arena_stats_json_entries(
+    Arena *arena,
+    StringList *json,
+    const char *key,
+    ArenaStatsEntry *entries,
+    usize count
+) {
+    string_list_push_back(arena, json, string_fmt(arena, "  \"{}\": [", string_from_cstring(key)));
+    for (usize i = 0; i < count; i++) {
+        String name = arena_stats_json_escape(arena, entries[i].name);
+        const char *fmt = "\n    {\"name\": \"{}\", \"bytes\": {u}, \"count\": {u}}{}";
+        String separator = i + 1 < count ? string_lit(",") : string_lit("\n  ");
+        String entry = string_fmt(arena, fmt, name, entries[i].bytes, entries[i].count, separator);
+        string_list_push_back(arena, json, entry);
+    }
+
+    string_list_push_back(arena, json, string_lit("]"));
+}
+
+// NOTE(cya): built in scratch, so dumping doesn't skew what it reports
+b32 arena_stats_store(Arena *arena, const char *path)
+{
+    ArenaStats *stats = arena->stats;
+    if (stats == NULL) {
+        return false;
+    }
+
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    Arena *temp = scratch.arena;
+    ArenaTotals totals = arena_totals(arena);
+    StringList json = {0};
+    String header = string_fmt(
+        temp,
+        "{\n"
+        "  \"used\": {u},\n"
+        "  \"high_water\": {u},\n"
+        "  \"committed\": {u},\n"
+        "  \"reserved\": {u},\n"
+        "  \"blocks\": {u},\n"
+        "  \"commits\": {u},\n"
+        "  \"commit_bytes\": {u},\n",
+        (u64)totals.used,
+        stats->high_water,
+        (u64)totals.committed,
+        (u64)totals.reserved,
+        totals.blocks,
+        stats->commits,
+        stats->commit_bytes
+    );
+    string_list_push_back(temp, &json, header);
+    arena_stats_json_entries(temp, &json, "tags", stats->tags, stats->tag_count);
+
+#if defined(BUILD_DEBUG)
+    // NOTE(cya): biggest first
+    ArenaStatsEntry *sites = arena_push_array(temp, stats->site_count, ArenaStatsEntry);
+    usize site_count = 0;
+    for (usize i = 0; i < ARENA_STATS_MAX_SITES; i++) {
+        ArenaStatsEntry entry = stats->sites[i];
+        if (entry.name == NULL) {
+            continue;
+        }
+
+        usize j = site_count++;
+        for (; j > 0 && sites[j - 1].bytes < entry.bytes; j--) {
+            sites[j] = sites[j - 1];
+        }
+
+        sites[j] = entry;
+    }
+
+    string_list_push_back(temp, &json, string_lit(",\n"));
+    arena_stats_json_entries(temp, &json, "sites", sites, site_count);
+    String misses = string_fmt(temp, ",\n  \"site_misses\": {u}", stats->site_misses);
+    string_list_push_back(temp, &json, misses);
+#endif
+
+    string_list_push_back(temp, &json, string_lit("\n}\n"));
+    String data = string_list_join(temp, &json, string_lit(""));
+    b32 is_stored = platform_file_write_atomic(temp, string_from_cstring(path), data);
+    arena_scratch_end(scratch);
+    return is_stored;
+}
+
+inline void arena_log_stats(Arena *arena)
+{
+    ArenaTotals totals = arena_totals(arena);
+    u64 usage = totals.reserved == 0 ? 0 : 100 * totals.used / totals.reserved;
+    const char *fmt = "memory usage: {u}% [used={size},committed={size},reserved={size},blocks={u}]";
+    log_debug(fmt, usage, (u64)totals.used, (u64)totals.committed, (u64)totals.reserved, totals.blocks);
 }
@@ -1,19 +1,116 @@
+typedef enum {
+    ARENA_HUGE_PAGES = 1 << 0, // NOTE(cya): transparent huge pages where available
+    ARENA_NO_RESERVE = 1 << 1, // NOTE(cya): commits aren't charged to swap up front
+    ARENA_DECOMMIT = 1 << 2, // NOTE(cya): resetting hands committed pages back
+    ARENA_FIXED = 1 << 3, // NOTE(cya): caller's buffer, never grows
+} ArenaFlags;
+
+// NOTE(cya): sits at the start of every block but the first and describes the
+// one before it, so popping a block restores the previous one
+typedef struct ArenaBlock ArenaBlock;
+struct ArenaBlock {
+    ArenaBlock *prev;
+    void *memory;
+    usize reserved;
+    usize committed;
+    usize base;
+};
+
+// NOTE(cya): threads carve chunks out of one reservation with a single atomic
+// add and allocate from them through their own child arena, without locking;
+// releasing the pool reclaims every child at once
+typedef struct {
+    void *memory;
+    usize reserved;
+    usize chunk_size; // NOTE(cya): smallest block a child claims
+    u64 next; // NOTE(cya): offset of the first unclaimed byte
+    u32 flags;
+} ArenaPool;
+
+#define ARENA_STATS_MAX_TAGS 32
+#define ARENA_STATS_MAX_SITES 512
+
+typedef struct {
+    const char *name;
+    u64 bytes;
+    u64 count;
+} ArenaStatsEntry;
+
+// NOTE(cya): opt-in, attached to one arena and updated on every push to it;
+// pushes are attributed to whichever tag was set last
+typedef struct {
+    u64 high_water; // NOTE(cya): highest position the arena reached
+    u64 commits; // NOTE(cya): each one faults in fresh pages
+    u64 commit_bytes;
+    u64 blocks; // NOTE(cya): reserved after the first one filled up
+
+    u32 tag; // NOTE(cya): index into `tags`, 0 is "untagged"
+    u32 tag_count;
+    ArenaStatsEntry tags[ARENA_STATS_MAX_TAGS];
+#if defined(BUILD_DEBUG)
+    u32 site_count;
+    u64 site_misses; // NOTE(cya): pushes from sites that didn't fit the table
+    ArenaStatsEntry sites[ARENA_STATS_MAX_SITES]; // NOTE(cya): keyed by address
+#endif
+} ArenaStats;
+
+// NOTE(cya): `memory` through `offset` describe the current block; once it's
+// full a new one is reserved and chained in front of it
 typedef struct {
     usize reserved;
     usize committed;
-    usize block_size;
+    usize block_size; // NOTE(cya): commit granularity
     usize offset;
     void *memory;
+
+    ArenaBlock *prev;
+    usize base; // NOTE(cya): arena position the current block starts at
+    usize reserve_size; // NOTE(cya): minimum reserve for a new block
+    ArenaPool *pool; // NOTE(cya): blocks are carved from it instead, when set
+    ArenaBlock *spare; // NOTE(cya): popped pool blocks, linked through `prev`
+    ArenaStats *stats;
+    u32 flags;
 } Arena;
 
-#define arena_init_from_buffer(b, s) ((Arena){.reserved = s, .committed = s, .memory = b})
+// NOTE(cya): everything pushed after `begin` goes away at `end`
+typedef struct {
+    Arena *arena;
+    usize pos;
+} ArenaTemp;
+
+#define ARENA_SCRATCH_COUNT 2
+
+#define arena_init_from_buffer(b, s) \
+    ((Arena){.reserved = s, .committed = s, .memory = b, .flags = ARENA_FIXED})
+#define arena_push(a, size) __arena_push(a, size, ARENA_SITE)
 #define arena_push_array(a, size, type) arena_push(a, (size) * sizeof(type))
 
-internal Arena arena_init(usize reserve_factor, usize commit);
+#if defined(BUILD_DEBUG)
+#    define ARENA_SITE __FILE__ ":" stringify_expanded(__LINE__)
+#else
+#    define ARENA_SITE NULL
+#endif
+
+internal Arena arena_init(usize reserve_factor, usize commit, u32 flags);
 internal void arena_release(Arena *arena);
 
-internal void *arena_push(Arena *arena, usize size);
+internal void *__arena_push(Arena *arena, usize size, const char *site);
+internal usize arena_pos(Arena *arena);
+internal void arena_pop_to(Arena *arena, usize pos);
 internal void arena_pop(Arena *arena, usize size);
 internal void arena_reset(Arena *arena);
 
+internal ArenaPool arena_pool_init(usize reserve, usize chunk_size, u32 flags);
+internal void arena_pool_release(ArenaPool *pool);
+internal Arena arena_pool_child(ArenaPool *pool);
+
+internal ArenaTemp arena_temp_begin(Arena *arena);
+internal void arena_temp_end(ArenaTemp temp);
+internal ArenaTemp arena_scratch_begin(Arena **conflicts, usize conflict_count);
+internal void arena_scratch_end(ArenaTemp scratch);
+internal void arena_scratch_release(void);
+
+internal void arena_stats_attach(Arena *arena, ArenaStats *stats);
+internal const char *arena_tag_set(Arena *arena, const char *tag);
+internal b32 arena_stats_store(Arena *arena, const char *path);
 internal void arena_log_stats(Arena *arena);
@@ -11,7 +11,8 @@ void assert_handle(
         return;
     }
 
-    Arena *arena = log.arena;
+    ArenaTemp scratch = arena_scratch_begin(NULL, 0);
+    Arena *arena = scratch.arena;
     String prefix = string_lit(_prefix);
     String cond = string_lit(_cond);
     String file = string_lit(_file);
@@ -20,7 +21,7 @@ void assert_handle(
     if (_msg != NULL) {
         va_list va;
         va_start(va, _msg);
-        msg = string_fmt(arena, _msg, va);
+        msg = string_fmt_va(arena, _msg, va);
         va_end(va);
     }
 
@@ -30,5 +31,6 @@ void assert_handle(
     }
 
     log_error("{}({}): {}{} {}", file, line, prefix, postfix, msg);
+    arena_scratch_end(scratch);
 }
 #endif
@@ -27,6 +27,16 @@
 
 #define assert(cond) assert_msg(cond, NULL)
 
+// NOTE(cya): for failures nothing above us could handle (out of memory in an
+// infallible push); unlike assert it stays in release builds. Fatal logs are
+// flushed right away, so the message is out before the trap
+#define assert_fatal(...) { \
+    log_fatal(__VA_ARGS__); \
+    debug_trap(); \
+    } noop()
+
+
+
 #if defined(BUILD_DEBUG)
 internal void assert_handle(
     const char *_prefix,
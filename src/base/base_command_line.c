@@ -8,9 +8,11 @@ inline CommandLine command_line_from_string_list(StringList *arguments)
 
 inline char **command_line_to_argv(Arena *arena, CommandLine *cmd_line, int *out_argc)
 {
-    StringList *arguments = cmd_line->arguments;
-    string_list_push_front(arena, arguments, cmd_line->exe_name);
-    return string_list_to_cstrings(arena, arguments, out_argc);
+    StringArray argv = string_array_init(arena, cmd_line->arguments->node_count + 1);
+    string_array_push(arena, &argv, cmd_line->exe_name);
+    string_array_push_list(arena, &argv, cmd_line->arguments);
+    *out_argc = (int)argv.count;
+    return string_array_to_cstrings(arena, &argv);
 }
 
 inline String command_line_escape_string(Arena *arena, String s)
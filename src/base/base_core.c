@@ -11,6 +11,29 @@ uptr align_forward(uptr value, uptr align)
     return modulo == 0 ? value : value + align - modulo;
 }
 
+// NOTE(cya): undefined for zero, callers check for a set bit first
+inline u32 count_trailing_zeros_u32(u32 value)
+{
+#if defined(COMPILER_MSVC)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return (u32)index;
+#else
+    return (u32)__builtin_ctz(value);
+#endif
+}
+
+inline u32 count_trailing_zeros_u64(u64 value)
+{
+#if defined(COMPILER_MSVC)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return (u32)index;
+#else
+    return (u32)__builtin_ctzll(value);
+#endif
+}
+
 // NOTE(cya): ASCII only
 inline b32 char_is_whitespace(char c)
 {
@@ -1,6 +1,17 @@
 #include <stdarg.h> // va_args
 #include <stdint.h> // sized integers
 
+#if defined(COMPILER_MSVC)
+#    include <intrin.h> // _BitScanForward
+#endif
+
+#if defined(ARCH_X64)
+#    include <emmintrin.h> // SSE2
+#    include <immintrin.h> // AVX2 (picked at runtime, see base_cpu)
+#elif defined(ARCH_ARM64)
+#    include <arm_neon.h> // NEON
+#endif
+
 typedef uint8_t u8;
 typedef uint16_t u16;
 typedef uint32_t u32;
@@ -49,14 +60,23 @@ typedef i32 b32;
 #define noop() ((void)0)
 #define unused(x) (void)sizeof(x)
 #define stringify(x) #x
+#define stringify_expanded(x) stringify(x)
 #define min(a, b) ((a) > (b) ? (b) : (a))
 #define max(a, b) ((a) > (b) ? (a) : (b))
 #define array_len(a) ((usize)sizeof(a) / sizeof(a[0]))
 #define mem_equal(d, s, len) platform_mem_equal(d, s, len)
 #define mem_copy(d, s, len) platform_mem_copy(d, s, len)
+#define mem_move(d, s, len) platform_mem_move(d, s, len)
 #define bit_flag(n) (1 << (n))
 #define is_power_of_two(v) (((v) & ((v) - 1)) == 0)
 
+// NOTE(cya): sequentially consistent, return the previous value
+#if defined(COMPILER_MSVC)
+#    define atomic_add_u64(p, v) ((u64)_InterlockedExchangeAdd64((volatile __int64*)(p), (__int64)(v)))
+#else
+#    define atomic_add_u64(p, v) __atomic_fetch_add((p), (u64)(v), __ATOMIC_SEQ_CST)
+#endif
+
 #define kibibytes(n) (1024 * (n))
 #define mebibytes(n) (1024 * kibibytes(n))
 #define gibibytes(n) (1024 * mebibytes(n))
@@ -84,6 +104,9 @@ typedef i32 b32;
 internal usize align_forward_size(usize value, usize align);
 internal uptr align_forward(uptr value, uptr align);
 
+internal u32 count_trailing_zeros_u32(u32 value);
+internal u32 count_trailing_zeros_u64(u64 value);
+
 internal b32 char_is_whitespace(char c);
 internal b32 char_is_digit(char c);
 
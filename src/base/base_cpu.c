@@ -0,0 +1,73 @@
+#if defined(ARCH_X64)
+internal inline void cpu_id(u32 leaf, u32 subleaf, u32 *out)
+{
+#if defined(COMPILER_MSVC)
+    int regs[4];
+    __cpuidex(regs, (int)leaf, (int)subleaf);
+    for (usize i = 0; i < 4; i++) {
+        out[i] = (u32)regs[i];
+    }
+#else
+    __asm__ volatile (
+        "cpuid"
+        : "=a"(out[0]), "=b"(out[1]), "=c"(out[2]), "=d"(out[3])
+        : "a"(leaf), "c"(subleaf)
+    );
+#endif
+}
+
+// NOTE(cya): which register sets the OS saves on context switches
+internal inline u64 cpu_xgetbv(void)
+{
+#if defined(COMPILER_MSVC)
+    return (u64)_xgetbv(0);
+#else
+    u32 lo, hi;
+    __asm__ volatile ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return ((u64)hi << 32) | lo;
+#endif
+}
+#endif
+
+void cpu_features_init(void)
+{
+    CpuFeatures features = {0};
+#if defined(ARCH_X64)
+    u32 regs[4];
+    cpu_id(0, 0, regs);
+    u32 max_leaf = regs[0];
+    cpu_id(1, 0, regs);
+    b32 has_osxsave = (regs[2] & bit_flag(27)) != 0;
+    b32 has_avx = (regs[2] & bit_flag(28)) != 0;
+    // NOTE(cya): the CPU having AVX isn't enough, the OS has to save the
+    // YMM registers too (XCR0 bits 1 and 2)
+    b32 has_ymm_state = has_osxsave && has_avx && (cpu_xgetbv() & 0x6) == 0x6;
+    if (max_leaf >= 7 && has_ymm_state) {
+        cpu_id(7, 0, regs);
+        features.has_avx2 = (regs[1] & bit_flag(5)) != 0;
+    }
+#endif
+    cpu_features = features;
+}
+
+// NOTE(cya): the TSC on x64, the virtual counter on arm64. Only good for
+// comparing spans on one machine (neither ticks at the core clock
+// everywhere), wall time comes from platform_get_time_ns
+inline u64 cpu_cycles(void)
+{
+#if defined(ARCH_X64) && defined(COMPILER_MSVC)
+    return __rdtsc();
+#elif defined(ARCH_X64)
+    u32 lo, hi;
+    __asm__ volatile ("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((u64)hi << 32) | lo;
+#elif defined(ARCH_ARM64) && defined(COMPILER_MSVC)
+    return (u64)_ReadStatusReg(0x5F02); // NOTE(cya): CNTVCT_EL0
+#elif defined(ARCH_ARM64)
+    u64 ticks;
+    __asm__ volatile ("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,23 @@
+// NOTE(cya): what the kernels in base may use beyond the build's baseline
+// (SSE2 on x64, NEON on arm64); filled in once at startup, everything reads
+// as unsupported before that
+typedef struct {
+    b32 has_avx2;
+} CpuFeatures;
+
+global CpuFeatures cpu_features;
+
+#if defined(COMPILER_MSVC)
+#    define target_avx2
+#else
+#    define target_avx2 __attribute__((target("avx2")))
+#endif
+
+#if defined(ARCH_X64) || defined(ARCH_ARM64)
+#    define CPU_HAS_CYCLE_COUNTER 1
+#else
+#    define CPU_HAS_CYCLE_COUNTER 0
+#endif
+
+internal void cpu_features_init(void);
+internal u64 cpu_cycles(void);
@@ -0,0 +1,655 @@
+#define HASH_PRIME32_1 0x9E3779B1u
+#define HASH_PRIME32_2 0x85EBCA77u
+#define HASH_PRIME32_3 0xC2B2AE3Du
+#define HASH_PRIME64_1 0x9E3779B185EBCA87ull
+#define HASH_PRIME64_2 0xC2B2AE3D27D4EB4Full
+#define HASH_PRIME64_3 0x165667B19E3779F9ull
+#define HASH_PRIME64_4 0x85EBCA77C2B2AE63ull
+#define HASH_PRIME64_5 0x27D4EB2F165667C5ull
+#define HASH_PRIME_MX1 0x165667919E3779F9ull
+#define HASH_PRIME_MX2 0x9FB21C651E98DF25ull
+
+#define HASH_MID_SIZE_MAX 240
+#define HASH_MID_START_OFFSET 3
+#define HASH_MID_LAST_OFFSET 17
+#define HASH_SECRET_SIZE_MIN 136
+#define HASH_SECRET_LAST_ACC_START 7
+#define HASH_SECRET_MERGE_ACCS_START 11
+#define HASH_BLOCK_STRIPES ((HASH_SECRET_SIZE - HASH_STRIPE_LEN) / 8)
+
+readonly global u8 __HASH_SECRET[HASH_SECRET_SIZE] = {
+    0xB8, 0xFE, 0x6C, 0x39, 0x23, 0xA4, 0x4B, 0xBE, 0x7C, 0x01, 0x81, 0x2C, 0xF7, 0x21, 0xAD, 0x1C,
+    0xDE, 0xD4, 0x6D, 0xE9, 0x83, 0x90, 0x97, 0xDB, 0x72, 0x40, 0xA4, 0xA4, 0xB7, 0xB3, 0x67, 0x1F,
+    0xCB, 0x79, 0xE6, 0x4E, 0xCC, 0xC0, 0xE5, 0x78, 0x82, 0x5A, 0xD0, 0x7D, 0xCC, 0xFF, 0x72, 0x21,
+    0xB8, 0x08, 0x46, 0x74, 0xF7, 0x43, 0x24, 0x8E, 0xE0, 0x35, 0x90, 0xE6, 0x81, 0x3A, 0x26, 0x4C,
+    0x3C, 0x28, 0x52, 0xBB, 0x91, 0xC3, 0x00, 0xCB, 0x88, 0xD0, 0x65, 0x8B, 0x1B, 0x53, 0x2E, 0xA3,
+    0x71, 0x64, 0x48, 0x97, 0xA2, 0x0D, 0xF9, 0x4E, 0x38, 0x19, 0xEF, 0x46, 0xA9, 0xDE, 0xAC, 0xD8,
+    0xA8, 0xFA, 0x76, 0x3F, 0xE3, 0x9C, 0x34, 0x3F, 0xF9, 0xDC, 0xBB, 0xC7, 0xC7, 0x0B, 0x4F, 0x1D,
+    0x8A, 0x51, 0xE0, 0x4B, 0xCD, 0xB4, 0x59, 0x31, 0xC8, 0x9F, 0x7E, 0xC9, 0xD9, 0x78, 0x73, 0x64,
+    0xEA, 0xC5, 0xAC, 0x83, 0x34, 0xD3, 0xEB, 0xC3, 0xC5, 0x81, 0xA0, 0xFF, 0xFA, 0x13, 0x63, 0xEB,
+    0x17, 0x0D, 0xDD, 0x51, 0xB7, 0xF0, 0xDA, 0x49, 0xD3, 0x16, 0x55, 0x26, 0x29, 0xD4, 0x68, 0x9E,
+    0x2B, 0x16, 0xBE, 0x58, 0x7D, 0x47, 0xA1, 0xFC, 0x8F, 0xF8, 0xB8, 0xD1, 0x7A, 0xD0, 0x31, 0xCE,
+    0x45, 0xCB, 0x3A, 0x8F, 0x95, 0x16, 0x04, 0x28, 0xAF, 0xD7, 0xFB, 0xCA, 0xBB, 0x4B, 0x40, 0x7E,
+};
+
+readonly global u64 __HASH_ACC_INIT[HASH_ACC_COUNT] = {
+    HASH_PRIME32_3, HASH_PRIME64_1, HASH_PRIME64_2, HASH_PRIME64_3,
+    HASH_PRIME64_4, HASH_PRIME32_2, HASH_PRIME64_5, HASH_PRIME32_1,
+};
+
+// NOTE(cya): every target we build for is little-endian
+internal inline u32 hash_read_u32(const u8 *p)
+{
+    u32 value;
+    mem_copy(&value, p, sizeof(value));
+    return value;
+}
+
+internal inline u64 hash_read_u64(const u8 *p)
+{
+    u64 value;
+    mem_copy(&value, p, sizeof(value));
+    return value;
+}
+
+internal inline u32 hash_swap_u32(u32 x)
+{
+    return (x << 24) | ((x << 8) & 0x00FF0000u) | ((x >> 8) & 0x0000FF00u) | (x >> 24);
+}
+
+internal inline u64 hash_swap_u64(u64 x)
+{
+    return ((u64)hash_swap_u32((u32)x) << 32) | hash_swap_u32((u32)(x >> 32));
+}
+
+internal inline u64 hash_rotl_u64(u64 x, u32 r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+internal inline Hash128 hash_mul_u64(u64 a, u64 b)
+{
+#if defined(COMPILER_MSVC) && defined(ARCH_X64)
+    Hash128 result;
+    result.lo = _umul128(a, b, &result.hi);
+    return result;
+#elif defined(COMPILER_MSVC)
+    return (Hash128){.lo = a * b, .hi = __umulh(a, b)};
+#else
+    __extension__ typedef unsigned __int128 u128;
+    u128 product = (u128)a * b;
+    return (Hash128){.lo = (u64)product, .hi = (u64)(product >> 64)};
+#endif
+}
+
+internal inline u64 hash_mul_fold_u64(u64 a, u64 b)
+{
+    Hash128 product = hash_mul_u64(a, b);
+    return product.lo ^ product.hi;
+}
+
+internal inline u64 hash_avalanche_xxh64(u64 h)
+{
+    h ^= h >> 33;
+    h *= HASH_PRIME64_2;
+    h ^= h >> 29;
+    h *= HASH_PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+internal inline u64 hash_avalanche(u64 h)
+{
+    h ^= h >> 37;
+    h *= HASH_PRIME_MX1;
+    h ^= h >> 32;
+    return h;
+}
+
+internal inline u64 hash_rrmxmx(u64 h, u64 len)
+{
+    h ^= hash_rotl_u64(h, 49) ^ hash_rotl_u64(h, 24);
+    h *= HASH_PRIME_MX2;
+    h ^= (h >> 35) + len;
+    h *= HASH_PRIME_MX2;
+    h ^= h >> 28;
+    return h;
+}
+
+internal inline u64 hash_mix_16(const u8 *input, const u8 *secret, u64 seed)
+{
+    u64 lo = hash_read_u64(input);
+    u64 hi = hash_read_u64(input + 8);
+    return hash_mul_fold_u64(
+        lo ^ (hash_read_u64(secret) + seed),
+        hi ^ (hash_read_u64(secret + 8) - seed)
+    );
+}
+
+// NOTE(cya): inputs up to 240 bytes never touch the accumulators, they're
+// folded straight into the result in a few size classes
+internal u64 hash_64_short(const u8 *input, usize len, const u8 *secret, u64 seed)
+{
+    if (len == 0) {
+        return hash_avalanche_xxh64(seed ^ hash_read_u64(secret + 56) ^ hash_read_u64(secret + 64));
+    }
+
+    if (len <= 3) {
+        u32 combined = ((u32)input[0] << 16) | ((u32)input[len >> 1] << 24) |
+            (u32)input[len - 1] | ((u32)len << 8);
+        u64 bitflip = (hash_read_u32(secret) ^ hash_read_u32(secret + 4)) + seed;
+        return hash_avalanche_xxh64((u64)combined ^ bitflip);
+    }
+
+    if (len <= 8) {
+        seed ^= (u64)hash_swap_u32((u32)seed) << 32;
+        u64 bitflip = (hash_read_u64(secret + 8) ^ hash_read_u64(secret + 16)) - seed;
+        u64 input_64 = hash_read_u32(input + len - 4) + ((u64)hash_read_u32(input) << 32);
+        return hash_rrmxmx(input_64 ^ bitflip, len);
+    }
+
+    if (len <= 16) {
+        u64 bitflip_lo = (hash_read_u64(secret + 24) ^ hash_read_u64(secret + 32)) + seed;
+        u64 bitflip_hi = (hash_read_u64(secret + 40) ^ hash_read_u64(secret + 48)) - seed;
+        u64 input_lo = hash_read_u64(input) ^ bitflip_lo;
+        u64 input_hi = hash_read_u64(input + len - 8) ^ bitflip_hi;
+        u64 acc = len + hash_swap_u64(input_lo) + input_hi + hash_mul_fold_u64(input_lo, input_hi);
+        return hash_avalanche(acc);
+    }
+
+    u64 acc = len * HASH_PRIME64_1;
+    if (len <= 128) {
+        for (usize i = (len - 1) / 32 + 1; i > 0; i--) {
+            usize offset = (i - 1) * 16;
+            acc += hash_mix_16(input + offset, secret + offset * 2, seed);
+            acc += hash_mix_16(input + len - offset - 16, secret + offset * 2 + 16, seed);
+        }
+
+        return hash_avalanche(acc);
+    }
+
+    for (usize i = 0; i < 8; i++) {
+        acc += hash_mix_16(input + 16 * i, secret + 16 * i, seed);
+    }
+
+    u64 acc_end = hash_mix_16(
+        input + len - 16,
+        secret + HASH_SECRET_SIZE_MIN - HASH_MID_LAST_OFFSET,
+        seed
+    );
+    acc = hash_avalanche(acc);
+    for (usize i = 8; i < len / 16; i++) {
+        acc_end += hash_mix_16(input + 16 * i, secret + 16 * (i - 8) + HASH_MID_START_OFFSET, seed);
+    }
+
+    return hash_avalanche(acc + acc_end);
+}
+
+internal inline Hash128 hash_mix_32(
+    Hash128 acc,
+    const u8 *input_1,
+    const u8 *input_2,
+    const u8 *secret,
+    u64 seed
+) {
+    acc.lo += hash_mix_16(input_1, secret, seed);
+    acc.lo ^= hash_read_u64(input_2) + hash_read_u64(input_2 + 8);
+    acc.hi += hash_mix_16(input_2, secret + 16, seed);
+    acc.hi ^= hash_read_u64(input_1) + hash_read_u64(input_1 + 8);
+    return acc;
+}
+
+internal inline Hash128 hash_128_mid_finish(Hash128 acc, usize len, u64 seed)
+{
+    u64 lo = acc.lo + acc.hi;
+    u64 hi = acc.lo * HASH_PRIME64_1 + acc.hi * HASH_PRIME64_4 + (len - seed) * HASH_PRIME64_2;
+    return (Hash128){.lo = hash_avalanche(lo), .hi = 0 - hash_avalanche(hi)};
+}
+
+internal Hash128 hash_128_short(const u8 *input, usize len, const u8 *secret, u64 seed)
+{
+    if (len == 0) {
+        u64 bitflip_lo = hash_read_u64(secret + 64) ^ hash_read_u64(secret + 72);
+        u64 bitflip_hi = hash_read_u64(secret + 80) ^ hash_read_u64(secret + 88);
+        return (Hash128){
+            .lo = hash_avalanche_xxh64(seed ^ bitflip_lo),
+            .hi = hash_avalanche_xxh64(seed ^ bitflip_hi),
+        };
+    }
+
+    if (len <= 3) {
+        u32 combined_lo = ((u32)input[0] << 16) | ((u32)input[len >> 1] << 24) |
+            (u32)input[len - 1] | ((u32)len << 8);
+        u32 swapped = hash_swap_u32(combined_lo);
+        u32 combined_hi = (swapped << 13) | (swapped >> 19);
+        u64 bitflip_lo = (hash_read_u32(secret) ^ hash_read_u32(secret + 4)) + seed;
+        u64 bitflip_hi = (hash_read_u32(secret + 8) ^ hash_read_u32(secret + 12)) - seed;
+        return (Hash128){
+            .lo = hash_avalanche_xxh64((u64)combined_lo ^ bitflip_lo),
+            .hi = hash_avalanche_xxh64((u64)combined_hi ^ bitflip_hi),
+        };
+    }
+
+    if (len <= 8) {
+        seed ^= (u64)hash_swap_u32((u32)seed) << 32;
+        u64 input_64 = hash_read_u32(input) + ((u64)hash_read_u32(input + len - 4) << 32);
+        u64 bitflip = (hash_read_u64(secret + 16) ^ hash_read_u64(secret + 24)) + seed;
+        Hash128 m = hash_mul_u64(input_64 ^ bitflip, HASH_PRIME64_1 + (len << 2));
+        m.hi += m.lo << 1;
+        m.lo ^= m.hi >> 3;
+        m.lo ^= m.lo >> 35;
+        m.lo *= HASH_PRIME_MX2;
+        m.lo ^= m.lo >> 28;
+        m.hi = hash_avalanche(m.hi);
+        return m;
+    }
+
+    if (len <= 16) {
+        u64 bitflip_lo = (hash_read_u64(secret + 32) ^ hash_read_u64(secret + 40)) - seed;
+        u64 bitflip_hi = (hash_read_u64(secret + 48) ^ hash_read_u64(secret + 56)) + seed;
+        u64 input_lo = hash_read_u64(input);
+        u64 input_hi = hash_read_u64(input + len - 8);
+        Hash128 m = hash_mul_u64(input_lo ^ input_hi ^ bitflip_lo, HASH_PRIME64_1);
+        m.lo += (u64)(len - 1) << 54;
+        input_hi ^= bitflip_hi;
+        m.hi += input_hi + (u64)(u32)input_hi * (HASH_PRIME32_2 - 1);
+        m.lo ^= hash_swap_u64(m.hi);
+        Hash128 h = hash_mul_u64(m.lo, HASH_PRIME64_2);
+        h.hi += m.hi * HASH_PRIME64_2;
+        return (Hash128){.lo = hash_avalanche(h.lo), .hi = hash_avalanche(h.hi)};
+    }
+
+    Hash128 acc = {.lo = len * HASH_PRIME64_1};
+    if (len <= 128) {
+        for (usize i = (len - 1) / 32 + 1; i > 0; i--) {
+            usize offset = (i - 1) * 16;
+            acc = hash_mix_32(acc, input + offset, input + len - offset - 16, secret + offset * 2, seed);
+        }
+
+        return hash_128_mid_finish(acc, len, seed);
+    }
+
+    for (usize i = 0; i < 4; i++) {
+        acc = hash_mix_32(acc, input + 32 * i, input + 32 * i + 16, secret + 32 * i, seed);
+    }
+
+    acc.lo = hash_avalanche(acc.lo);
+    acc.hi = hash_avalanche(acc.hi);
+    for (usize i = 4; i < len / 32; i++) {
+        const u8 *key = secret + HASH_MID_START_OFFSET + 32 * (i - 4);
+        acc = hash_mix_32(acc, input + 32 * i, input + 32 * i + 16, key, seed);
+    }
+
+    acc = hash_mix_32(
+        acc,
+        input + len - 16,
+        input + len - 32,
+        secret + HASH_SECRET_SIZE_MIN - HASH_MID_LAST_OFFSET - 16,
+        0 - seed
+    );
+    return hash_128_mid_finish(acc, len, seed);
+}
+
+// NOTE(cya): long inputs run through 8 lanes of 64-bit accumulators, one
+// 64-byte stripe at a time, with the secret sliding 8 bytes per stripe; the
+// lanes are scrambled after every block of 16 stripes. This is the only part
+// worth vectorising, the kernels below keep the lanes in registers across
+// all the stripes they're handed
+internal inline void hash_accumulate_scalar(u64 *acc, const u8 *input, const u8 *secret, usize stripes)
+{
+    for (usize n = 0; n < stripes; n++) {
+        const u8 *stripe = input + n * HASH_STRIPE_LEN;
+        const u8 *key = secret + n * 8;
+        for (usize i = 0; i < HASH_ACC_COUNT; i++) {
+            u64 data = hash_read_u64(stripe + 8 * i);
+            u64 keyed = data ^ hash_read_u64(key + 8 * i);
+            acc[i ^ 1] += data;
+            acc[i] += (u64)(u32)keyed * (keyed >> 32);
+        }
+    }
+}
+
+internal inline void hash_scramble_scalar(u64 *acc, const u8 *secret)
+{
+    for (usize i = 0; i < HASH_ACC_COUNT; i++) {
+        u64 lane = acc[i];
+        lane ^= lane >> 47;
+        lane ^= hash_read_u64(secret + 8 * i);
+        acc[i] = lane * HASH_PRIME32_1;
+    }
+}
+
+#if defined(ARCH_X64)
+target_avx2 internal void hash_accumulate_avx2(u64 *acc, const u8 *input, const u8 *secret, usize stripes)
+{
+    __m256i lanes[2] = {
+        _mm256_loadu_si256((const __m256i*)acc),
+        _mm256_loadu_si256((const __m256i*)(acc + 4)),
+    };
+    for (usize n = 0; n < stripes; n++) {
+        const u8 *stripe = input + n * HASH_STRIPE_LEN;
+        const u8 *key = secret + n * 8;
+        for (usize i = 0; i < 2; i++) {
+            __m256i data = _mm256_loadu_si256((const __m256i*)(stripe + 32 * i));
+            __m256i keyed = _mm256_xor_si256(data, _mm256_loadu_si256((const __m256i*)(key + 32 * i)));
+            __m256i keyed_hi = _mm256_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1));
+            __m256i product = _mm256_mul_epu32(keyed, keyed_hi);
+            __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+            lanes[i] = _mm256_add_epi64(lanes[i], _mm256_add_epi64(product, swapped));
+        }
+    }
+
+    _mm256_storeu_si256((__m256i*)acc, lanes[0]);
+    _mm256_storeu_si256((__m256i*)(acc + 4), lanes[1]);
+}
+
+target_avx2 internal void hash_scramble_avx2(u64 *acc, const u8 *secret)
+{
+    __m256i prime = _mm256_set1_epi32((int)HASH_PRIME32_1);
+    for (usize i = 0; i < 2; i++) {
+        __m256i lane = _mm256_loadu_si256((const __m256i*)(acc + 4 * i));
+        lane = _mm256_xor_si256(lane, _mm256_srli_epi64(lane, 47));
+        lane = _mm256_xor_si256(lane, _mm256_loadu_si256((const __m256i*)(secret + 32 * i)));
+        __m256i product_lo = _mm256_mul_epu32(lane, prime);
+        __m256i product_hi = _mm256_mul_epu32(_mm256_srli_epi64(lane, 32), prime);
+        lane = _mm256_add_epi64(product_lo, _mm256_slli_epi64(product_hi, 32));
+        _mm256_storeu_si256((__m256i*)(acc + 4 * i), lane);
+    }
+}
+
+internal void hash_accumulate_sse2(u64 *acc, const u8 *input, const u8 *secret, usize stripes)
+{
+    __m128i lanes[4];
+    for (usize i = 0; i < 4; i++) {
+        lanes[i] = _mm_loadu_si128((const __m128i*)(acc + 2 * i));
+    }
+
+    for (usize n = 0; n < stripes; n++) {
+        const u8 *stripe = input + n * HASH_STRIPE_LEN;
+        const u8 *key = secret + n * 8;
+        for (usize i = 0; i < 4; i++) {
+            __m128i data = _mm_loadu_si128((const __m128i*)(stripe + 16 * i));
+            __m128i keyed = _mm_xor_si128(data, _mm_loadu_si128((const __m128i*)(key + 16 * i)));
+            __m128i keyed_hi = _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1));
+            __m128i product = _mm_mul_epu32(keyed, keyed_hi);
+            __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+            lanes[i] = _mm_add_epi64(lanes[i], _mm_add_epi64(product, swapped));
+        }
+    }
+
+    for (usize i = 0; i < 4; i++) {
+        _mm_storeu_si128((__m128i*)(acc + 2 * i), lanes[i]);
+    }
+}
+
+internal void hash_scramble_sse2(u64 *acc, const u8 *secret)
+{
+    __m128i prime = _mm_set1_epi32((int)HASH_PRIME32_1);
+    for (usize i = 0; i < 4; i++) {
+        __m128i lane = _mm_loadu_si128((const __m128i*)(acc + 2 * i));
+        lane = _mm_xor_si128(lane, _mm_srli_epi64(lane, 47));
+        lane = _mm_xor_si128(lane, _mm_loadu_si128((const __m128i*)(secret + 16 * i)));
+        __m128i product_lo = _mm_mul_epu32(lane, prime);
+        __m128i product_hi = _mm_mul_epu32(_mm_srli_epi64(lane, 32), prime);
+        lane = _mm_add_epi64(product_lo, _mm_slli_epi64(product_hi, 32));
+        _mm_storeu_si128((__m128i*)(acc + 2 * i), lane);
+    }
+}
+#elif defined(ARCH_ARM64)
+internal void hash_accumulate_neon(u64 *acc, const u8 *input, const u8 *secret, usize stripes)
+{
+    uint64x2_t lanes[4];
+    for (usize i = 0; i < 4; i++) {
+        lanes[i] = vld1q_u64(acc + 2 * i);
+    }
+
+    for (usize n = 0; n < stripes; n++) {
+        const u8 *stripe = input + n * HASH_STRIPE_LEN;
+        const u8 *key = secret + n * 8;
+        for (usize i = 0; i < 4; i++) {
+            uint64x2_t data = vreinterpretq_u64_u8(vld1q_u8(stripe + 16 * i));
+            uint64x2_t keyed = veorq_u64(data, vreinterpretq_u64_u8(vld1q_u8(key + 16 * i)));
+            lanes[i] = vaddq_u64(lanes[i], vextq_u64(data, data, 1));
+            lanes[i] = vmlal_u32(lanes[i], vmovn_u64(keyed), vshrn_n_u64(keyed, 32));
+        }
+    }
+
+    for (usize i = 0; i < 4; i++) {
+        vst1q_u64(acc + 2 * i, lanes[i]);
+    }
+}
+
+internal void hash_scramble_neon(u64 *acc, const u8 *secret)
+{
+    uint32x2_t prime = vdup_n_u32(HASH_PRIME32_1);
+    for (usize i = 0; i < 4; i++) {
+        uint64x2_t lane = vld1q_u64(acc + 2 * i);
+        lane = veorq_u64(lane, vshrq_n_u64(lane, 47));
+        lane = veorq_u64(lane, vreinterpretq_u64_u8(vld1q_u8(secret + 16 * i)));
+        uint64x2_t product_hi = vshlq_n_u64(vmull_u32(vshrn_n_u64(lane, 32), prime), 32);
+        vst1q_u64(acc + 2 * i, vmlal_u32(product_hi, vmovn_u64(lane), prime));
+    }
+}
+#endif
+
+internal void hash_accumulate(u64 *acc, const u8 *input, const u8 *secret, usize stripes)
+{
+#if defined(ARCH_X64)
+    if (cpu_features.has_avx2) {
+        hash_accumulate_avx2(acc, input, secret, stripes);
+    } else {
+        hash_accumulate_sse2(acc, input, secret, stripes);
+    }
+#elif defined(ARCH_ARM64)
+    hash_accumulate_neon(acc, input, secret, stripes);
+#else
+    hash_accumulate_scalar(acc, input, secret, stripes);
+#endif
+}
+
+internal void hash_scramble(u64 *acc, const u8 *secret)
+{
+#if defined(ARCH_X64)
+    if (cpu_features.has_avx2) {
+        hash_scramble_avx2(acc, secret);
+    } else {
+        hash_scramble_sse2(acc, secret);
+    }
+#elif defined(ARCH_ARM64)
+    hash_scramble_neon(acc, secret);
+#else
+    hash_scramble_scalar(acc, secret);
+#endif
+}
+
+// NOTE(cya): `block_stripes` carries the position inside the current block
+// over from previous calls, so streamed input lines up with one-shot
+internal void hash_consume_stripes(u64 *acc, u32 *block_stripes, const u8 *input, usize stripes, const u8 *secret)
+{
+    while (stripes > 0) {
+        usize left = HASH_BLOCK_STRIPES - *block_stripes;
+        usize count = min(left, stripes);
+        hash_accumulate(acc, input, secret + *block_stripes * 8, count);
+        input += count * HASH_STRIPE_LEN;
+        stripes -= count;
+        *block_stripes += (u32)count;
+        if (*block_stripes == HASH_BLOCK_STRIPES) {
+            hash_scramble(acc, secret + HASH_SECRET_SIZE - HASH_STRIPE_LEN);
+            *block_stripes = 0;
+        }
+    }
+}
+
+internal inline u64 hash_merge_accs(u64 *acc, const u8 *secret, u64 start)
+{
+    u64 result = start;
+    for (usize i = 0; i < 4; i++) {
+        result += hash_mul_fold_u64(
+            acc[2 * i] ^ hash_read_u64(secret + 16 * i),
+            acc[2 * i + 1] ^ hash_read_u64(secret + 16 * i + 8)
+        );
+    }
+
+    return hash_avalanche(result);
+}
+
+internal inline Hash128 hash_long_finish(u64 *acc, const u8 *secret, u64 len)
+{
+    return (Hash128){
+        .lo = hash_merge_accs(acc, secret + HASH_SECRET_MERGE_ACCS_START, len * HASH_PRIME64_1),
+        .hi = hash_merge_accs(
+            acc,
+            secret + HASH_SECRET_SIZE - HASH_STRIPE_LEN - HASH_SECRET_MERGE_ACCS_START,
+            ~(len * HASH_PRIME64_2)
+        ),
+    };
+}
+
+// NOTE(cya): every stripe but the one holding the last byte is consumed, that
+// one is always taken as the final 64 bytes of input (overlapping if need be)
+internal Hash128 hash_long(const u8 *input, usize len, const u8 *secret)
+{
+    u64 acc[HASH_ACC_COUNT];
+    mem_copy(acc, __HASH_ACC_INIT, sizeof(acc));
+
+    u32 block_stripes = 0;
+    hash_consume_stripes(acc, &block_stripes, input, (len - 1) / HASH_STRIPE_LEN, secret);
+    const u8 *last_secret = secret + HASH_SECRET_SIZE - HASH_STRIPE_LEN - HASH_SECRET_LAST_ACC_START;
+    hash_accumulate(acc, input + len - HASH_STRIPE_LEN, last_secret, 1);
+    return hash_long_finish(acc, secret, len);
+}
+
+// NOTE(cya): seeded long hashes run on a secret shifted by the seed
+internal inline void hash_secret_derive(u8 *secret, u64 seed)
+{
+    for (usize i = 0; i < HASH_SECRET_SIZE; i += 16) {
+        u64 lo = hash_read_u64(__HASH_SECRET + i) + seed;
+        u64 hi = hash_read_u64(__HASH_SECRET + i + 8) - seed;
+        mem_copy(secret + i, &lo, sizeof(lo));
+        mem_copy(secret + i + 8, &hi, sizeof(hi));
+    }
+}
+
+u64 hash_64(String data, u64 seed)
+{
+    if (data.len <= HASH_MID_SIZE_MAX) {
+        return hash_64_short(data.str, data.len, __HASH_SECRET, seed);
+    }
+
+    if (seed == 0) {
+        return hash_long(data.str, data.len, __HASH_SECRET).lo;
+    }
+
+    u8 secret[HASH_SECRET_SIZE];
+    hash_secret_derive(secret, seed);
+    return hash_long(data.str, data.len, secret).lo;
+}
+
+inline Hash128 hash_128(String data, u64 seed)
+{
+    if (data.len <= HASH_MID_SIZE_MAX) {
+        return hash_128_short(data.str, data.len, __HASH_SECRET, seed);
+    }
+
+    if (seed == 0) {
+        return hash_long(data.str, data.len, __HASH_SECRET);
+    }
+
+    u8 secret[HASH_SECRET_SIZE];
+    hash_secret_derive(secret, seed);
+    return hash_long(data.str, data.len, secret);
+}
+
+void hash_state_init(HashState *state, u64 seed)
+{
+    mem_copy(state->acc, __HASH_ACC_INIT, sizeof(state->acc));
+    hash_secret_derive(state->secret, seed);
+    state->buffered = 0;
+    state->total_len = 0;
+    state->seed = seed;
+    state->block_stripes = 0;
+}
+
+// NOTE(cya): a full buffer is only consumed once more input shows up, so
+// whatever is left at the end always holds the last byte
+void hash_update(HashState *state, String data)
+{
+    state->total_len += data.len;
+    if (state->buffered + data.len <= HASH_BUFFER_SIZE) {
+        mem_copy(state->buffer + state->buffered, data.str, data.len);
+        state->buffered += data.len;
+        return;
+    }
+
+    const u8 *input = data.str;
+    usize len = data.len;
+    usize stripes = HASH_BUFFER_SIZE / HASH_STRIPE_LEN;
+    if (state->buffered > 0) {
+        usize fill = HASH_BUFFER_SIZE - state->buffered;
+        mem_copy(state->buffer + state->buffered, input, fill);
+        hash_consume_stripes(state->acc, &state->block_stripes, state->buffer, stripes, state->secret);
+        input += fill;
+        len -= fill;
+    }
+
+    if (len > HASH_BUFFER_SIZE) {
+        while (len > HASH_BUFFER_SIZE) {
+            hash_consume_stripes(state->acc, &state->block_stripes, input, stripes, state->secret);
+            input += HASH_BUFFER_SIZE;
+            len -= HASH_BUFFER_SIZE;
+        }
+
+        // NOTE(cya): the digest may still need the tail of what was consumed
+        u8 *tail = state->buffer + HASH_BUFFER_SIZE - HASH_STRIPE_LEN;
+        mem_copy(tail, input - HASH_STRIPE_LEN, HASH_STRIPE_LEN);
+    }
+
+    mem_copy(state->buffer, input, len);
+    state->buffered = len;
+}
+
+inline void hash_update_u64(HashState *state, u64 value)
+{
+    hash_update(state, string_create(&value, sizeof(value)));
+}
+
+internal Hash128 hash_digest_long(HashState *state)
+{
+    u64 acc[HASH_ACC_COUNT];
+    mem_copy(acc, state->acc, sizeof(acc));
+
+    u8 last[HASH_STRIPE_LEN];
+    u32 block_stripes = state->block_stripes;
+    if (state->buffered >= HASH_STRIPE_LEN) {
+        usize stripes = (state->buffered - 1) / HASH_STRIPE_LEN;
+        hash_consume_stripes(acc, &block_stripes, state->buffer, stripes, state->secret);
+        mem_copy(last, state->buffer + state->buffered - HASH_STRIPE_LEN, HASH_STRIPE_LEN);
+    } else {
+        // NOTE(cya): stitched back together from the previous buffer's tail
+        usize carried = HASH_STRIPE_LEN - state->buffered;
+        mem_copy(last, state->buffer + HASH_BUFFER_SIZE - carried, carried);
+        mem_copy(last + carried, state->buffer, state->buffered);
+    }
+
+    const u8 *last_secret = state->secret + HASH_SECRET_SIZE - HASH_STRIPE_LEN - HASH_SECRET_LAST_ACC_START;
+    hash_accumulate(acc, last, last_secret, 1);
+    return hash_long_finish(acc, state->secret, state->total_len);
+}
+
+u64 hash_digest_64(HashState *state)
+{
+    if (state->total_len <= HASH_MID_SIZE_MAX) {
+        return hash_64_short(state->buffer, state->total_len, __HASH_SECRET, state->seed);
+    }
+
+    return hash_digest_long(state).lo;
+}
+
+inline Hash128 hash_digest_128(HashState *state)
+{
+    if (state->total_len <= HASH_MID_SIZE_MAX) {
+        return hash_128_short(state->buffer, state->total_len, __HASH_SECRET, state->seed);
+    }
+
+    return hash_digest_long(state);
+}
@@ -0,0 +1,33 @@
+// NOTE(cya): XXH3 (64 and 128-bit, seeded), bit-compatible with the reference
+// implementation; non-cryptographic, meant for cache keys, fingerprints and
+// hash maps
+#define HASH_STRIPE_LEN 64
+#define HASH_SECRET_SIZE 192
+#define HASH_ACC_COUNT 8
+#define HASH_BUFFER_SIZE (4 * HASH_STRIPE_LEN)
+
+typedef struct {
+    u64 lo;
+    u64 hi;
+} Hash128;
+
+// NOTE(cya): for input that arrives in pieces, hashes the same as the
+// one-shot functions over the concatenation
+typedef struct {
+    u64 acc[HASH_ACC_COUNT];
+    u8 secret[HASH_SECRET_SIZE]; // NOTE(cya): derived from the seed
+    u8 buffer[HASH_BUFFER_SIZE];
+    usize buffered;
+    u64 total_len;
+    u64 seed;
+    u32 block_stripes; // NOTE(cya): stripes consumed since the last scramble
+} HashState;
+
+internal u64 hash_64(String data, u64 seed);
+internal Hash128 hash_128(String data, u64 seed);
+
+internal void hash_state_init(HashState *state, u64 seed);
+internal void hash_update(HashState *state, String data);
+internal void hash_update_u64(HashState *state, u64 value);
+internal u64 hash_digest_64(HashState *state);
+internal Hash128 hash_digest_128(HashState *state);
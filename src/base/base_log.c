@@ -1,34 +1,125 @@
-inline void __log(const char *level, const char *fmt, ...)
+readonly global char *LOG_LEVEL_NAMES[] = {"debug", "info", "warn", "error", "fatal", "off"};
+readonly global char *LOG_LEVEL_PREFIXES[] = {"DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
+
+global thread_local File __log_sink;
+
+// NOTE(cya): debug builds show everything by default, the level can still be
+// changed at runtime either way
+inline void log_init(Arena *arena)
 {
-    va_list va;
-    va_start(va, fmt);
-    __log_va(level, fmt, va);
-    va_end(va);
+    log.arena = arena;
+#if defined(BUILD_DEBUG)
+    log.level = LOG_LEVEL_DEBUG;
+#else
+    log.level = LOG_LEVEL_INFO;
+#endif
+    __log_sink = platform_get_std_file(STDOUT);
+    log.head = 0;
+    log.tail = 0;
 }
 
-inline void log_debug(const char *fmt, ...)
+b32 log_level_parse(String name, LogLevel *out)
+{
+    for (usize i = 0; i < array_len(LOG_LEVEL_NAMES); i++) {
+        if (string_equals(name, string_from_cstring(LOG_LEVEL_NAMES[i]))) {
+            *out = (LogLevel)i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// NOTE(cya): replaces stdout from here on, whatever is buffered still goes
+// there first
+b32 log_set_file(Arena *arena, String path)
+{
+    File file = platform_file_create(arena, path);
+    if (!platform_file_is_valid(file)) {
+        return false;
+    }
+
+    log_flush();
+    __log_sink = file;
+    return true;
+}
+
+void log_flush(void)
+{
+    usize pending = (usize)(log.head - log.tail);
+    if (pending == 0) {
+        return;
+    }
+
+    usize start = (usize)(log.tail & (LOG_RING_SIZE - 1));
+    usize first = min(pending, LOG_RING_SIZE - start);
+    String parts[] = {
+        string_create(&log.ring[start], first),
+        string_create(log.ring, pending - first),
+    };
+    platform_file_write_strings(__log_sink, parts, array_len(parts));
+    log.tail = log.head;
+}
+
+internal void log_append(String line)
+{
+    if (line.len > LOG_RING_SIZE - (usize)(log.head - log.tail)) {
+        log_flush();
+    }
+
+    // NOTE(cya): too big to ever be buffered, so it goes straight out (after
+    // everything before it)
+    if (line.len > LOG_RING_SIZE) {
+        platform_file_write_string(__log_sink, line);
+        return;
+    }
+
+    usize start = (usize)(log.head & (LOG_RING_SIZE - 1));
+    usize first = min(line.len, LOG_RING_SIZE - start);
+    mem_copy(&log.ring[start], line.str, first);
+    mem_copy(log.ring, &line.str[first], line.len - first);
+    log.head += line.len;
+}
+
+inline void __log(LogLevel level, const char *fmt, ...)
 {
-#if defined(BUILD_DEBUG)
     va_list va;
     va_start(va, fmt);
-    __log_va("DEBUG", fmt, va);
+    __log_va(level, fmt, va);
     va_end(va);
-#else
-    unused(fmt);
-#endif
 }
 
-inline void __log_va(const char *level, const char *fmt, va_list va)
+// NOTE(cya): the whole line is formatted once, into the stack buffer when it
+// fits (scratch only sees the odd long one), then buffered. Errors are flushed
+// right away so they aren't lost to a crash
+inline void __log_va(LogLevel level, const char *fmt, va_list va)
 {
-    if (log.arena == NULL) {
+    if (log.arena == NULL || level < log.level) {
         return;
     }
 
-    File file = platform_get_std_file(STDOUT);
+    u8 buf[LOG_LINE_BUFFER_SIZE];
     String newline = string_lit(PLATFORM_LINE_SEPARATOR);
-    String msg = string_fmt_va(log.arena, fmt, va);
-    String log_level = string_from_cstring(level);
-    String line = string_fmt(log.arena, "[{}] {}{}", log_level, msg, newline);
+    String name = string_from_cstring(LOG_LEVEL_PREFIXES[level]);
+    String prefix = string_fmt_buf(buf, sizeof(buf), "[{}] ", name);
+    usize cap = sizeof(buf) - prefix.len - newline.len;
+
+    va_list measure;
+    va_copy(measure, va);
+    String msg = string_fmt_buf_va(&buf[prefix.len], cap, fmt, measure);
+    va_end(measure);
 
-    platform_file_write_string(file, line);
+    if (msg.len < cap) {
+        mem_copy(&buf[prefix.len + msg.len], newline.str, newline.len);
+        log_append(string_create(buf, prefix.len + msg.len + newline.len));
+    } else {
+        ArenaTemp scratch = arena_scratch_begin(NULL, 0);
+        msg = string_fmt_va(scratch.arena, fmt, va);
+        log_append(string_fmt(scratch.arena, "{}{}{}", prefix, msg, newline));
+        arena_scratch_end(scratch);
+    }
+
+    if (level >= LOG_LEVEL_ERROR) {
+        log_flush();
+    }
 }
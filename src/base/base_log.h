@@ -1,14 +1,36 @@
+typedef enum {
+    LOG_LEVEL_DEBUG,
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARN,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_FATAL,
+    LOG_LEVEL_OFF,
+} LogLevel;
+
+#define LOG_LINE_BUFFER_SIZE kibibytes(1)
+#define LOG_RING_SIZE kibibytes(8) // NOTE(cya): has to be a power of two
+
+// NOTE(cya): whole lines collect in `ring` and go out in batches, one writev
+// each; nothing here grows however much gets logged
 typedef struct {
     Arena *arena;
+    LogLevel level; // NOTE(cya): anything below it is dropped
+    u64 head; // NOTE(cya): bytes ever buffered
+    u64 tail; // NOTE(cya): bytes ever flushed
+    u8 ring[LOG_RING_SIZE];
 } Log;
 
 global thread_local Log log;
 
-#define log_info(...) __log("INFO", __VA_ARGS__)
-#define log_warn(...) __log("WARN", __VA_ARGS__)
-#define log_error(...) __log("ERROR", __VA_ARGS__)
-#define log_fatal(...) __log("FATAL", __VA_ARGS__)
+#define log_debug(...) __log(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define log_info(...) __log(LOG_LEVEL_INFO, __VA_ARGS__)
+#define log_warn(...) __log(LOG_LEVEL_WARN, __VA_ARGS__)
+#define log_error(...) __log(LOG_LEVEL_ERROR, __VA_ARGS__)
+#define log_fatal(...) __log(LOG_LEVEL_FATAL, __VA_ARGS__)
 
-internal void __log(const char *level, const char *fmt, ...);
-internal void log_debug(const char *fmt, ...);
-internal void __log_va(const char *level, const char *fmt, va_list va);
+internal void log_init(Arena *arena);
+internal b32 log_level_parse(String name, LogLevel *out);
+internal b32 log_set_file(Arena *arena, String path);
+internal void log_flush(void);
+internal void __log(LogLevel level, const char *fmt, ...);
+internal void __log_va(LogLevel level, const char *fmt, va_list va);
@@ -0,0 +1,157 @@
+#define HASH_MAP_MIN_CAPACITY 16
+
+// NOTE(cya): keeps the load under 7/8, Robin Hood probing stays short there
+internal inline usize hash_map_capacity_for(usize count)
+{
+    usize capacity = HASH_MAP_MIN_CAPACITY;
+    while (capacity * 7 < count * 8) {
+        capacity *= 2;
+    }
+
+    return capacity;
+}
+
+internal HashMapSlot *hash_map_alloc_slots(Arena *arena, usize capacity)
+{
+    HashMapSlot *slots = arena_push_array(arena, capacity, HashMapSlot);
+    for (usize i = 0; i < capacity; i++) {
+        slots[i].distance = 0;
+    }
+
+    return slots;
+}
+
+HashMap hash_map_init(Arena *arena, usize count)
+{
+    usize capacity = hash_map_capacity_for(count);
+    return (HashMap){
+        .arena = arena,
+        .slots = hash_map_alloc_slots(arena, capacity),
+        .capacity = capacity,
+    };
+}
+
+// NOTE(cya): richer entries (closer to home) give their slot up to poorer
+// ones, returns wherever `entry` itself ended up
+internal HashMapSlot *hash_map_place(HashMap *map, HashMapSlot entry)
+{
+    usize mask = map->capacity - 1;
+    HashMapSlot *placed = NULL;
+    entry.distance = 1;
+    for (usize i = (usize)entry.hash & mask;; i = (i + 1) & mask) {
+        HashMapSlot *slot = &map->slots[i];
+        if (slot->distance == 0) {
+            *slot = entry;
+            return placed != NULL ? placed : slot;
+        }
+
+        if (slot->distance < entry.distance) {
+            HashMapSlot evicted = *slot;
+            *slot = entry;
+            entry = evicted;
+            if (placed == NULL) {
+                placed = slot;
+            }
+        }
+
+        entry.distance += 1;
+    }
+}
+
+void hash_map_reserve(HashMap *map, usize count)
+{
+    usize capacity = hash_map_capacity_for(count);
+    if (capacity <= map->capacity) {
+        return;
+    }
+
+    HashMap grown = {
+        .arena = map->arena,
+        .slots = hash_map_alloc_slots(map->arena, capacity),
+        .capacity = capacity,
+        .count = map->count,
+    };
+    for (usize i = 0; i < map->capacity; i++) {
+        if (map->slots[i].distance != 0) {
+            hash_map_place(&grown, map->slots[i]);
+        }
+    }
+
+    *map = grown;
+}
+
+internal HashMapSlot *hash_map_lookup(HashMap *map, String key, u64 hash)
+{
+    usize mask = map->capacity - 1;
+    u32 distance = 1;
+    for (usize i = (usize)hash & mask;; i = (i + 1) & mask, distance++) {
+        // NOTE(cya): a free slot, or one closer to home than we are, means
+        // the key would have been placed before this point
+        HashMapSlot *slot = &map->slots[i];
+        if (slot->distance < distance) {
+            return NULL;
+        }
+
+        if (slot->hash == hash && string_equals(slot->key, key)) {
+            return slot;
+        }
+    }
+}
+
+inline HashMapSlot *hash_map_find(HashMap *map, String key)
+{
+    return hash_map_lookup(map, key, hash_64(key, 0));
+}
+
+inline b32 hash_map_get(HashMap *map, String key, u64 *out)
+{
+    HashMapSlot *slot = hash_map_find(map, key);
+    if (slot == NULL) {
+        return false;
+    }
+
+    *out = slot->value;
+    return true;
+}
+
+// NOTE(cya): first one wins, false when the key was already there
+b32 hash_map_insert(HashMap *map, String key, u64 value)
+{
+    u64 hash = hash_64(key, 0);
+    if (hash_map_lookup(map, key, hash) != NULL) {
+        return false;
+    }
+
+    hash_map_reserve(map, map->count + 1);
+    hash_map_place(map, (HashMapSlot){.hash = hash, .key = key, .value = value});
+    map->count += 1;
+    return true;
+}
+
+// NOTE(cya): last one wins
+inline void hash_map_put(HashMap *map, String key, u64 value)
+{
+    u64 hash = hash_64(key, 0);
+    HashMapSlot *slot = hash_map_lookup(map, key, hash);
+    if (slot != NULL) {
+        slot->value = value;
+        return;
+    }
+
+    hash_map_reserve(map, map->count + 1);
+    hash_map_place(map, (HashMapSlot){.hash = hash, .key = key, .value = value});
+    map->count += 1;
+}
+
+// NOTE(cya): slot order, which is as good as random; NULL starts and ends it
+inline HashMapSlot *hash_map_next(HashMap *map, HashMapSlot *slot)
+{
+    HashMapSlot *end = map->slots + map->capacity;
+    for (slot = slot == NULL ? map->slots : slot + 1; slot < end; slot++) {
+        if (slot->distance != 0) {
+            return slot;
+        }
+    }
+
+    return NULL;
+}
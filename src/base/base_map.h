@@ -0,0 +1,27 @@
+// NOTE(cya): Robin Hood open addressing keyed by string views (the bytes
+// aren't copied); slots come from the arena and the old array is simply
+// abandoned when the map grows
+typedef struct {
+    u64 hash;
+    String key;
+    u64 value;
+    u32 distance; // NOTE(cya): probe length plus one, 0 marks a free slot
+} HashMapSlot;
+
+typedef struct {
+    Arena *arena;
+    HashMapSlot *slots;
+    usize capacity; // NOTE(cya): always a power of two
+    usize count;
+} HashMap;
+
+#define hash_map_foreach(m, s) \
+    for (HashMapSlot *(s) = hash_map_next((m), NULL); (s) != NULL; (s) = hash_map_next((m), (s)))
+
+internal HashMap hash_map_init(Arena *arena, usize count);
+internal void hash_map_reserve(HashMap *map, usize count);
+internal HashMapSlot *hash_map_find(HashMap *map, String key);
+internal b32 hash_map_get(HashMap *map, String key, u64 *out);
+internal b32 hash_map_insert(HashMap *map, String key, u64 value);
+internal void hash_map_put(HashMap *map, String key, u64 value);
+internal HashMapSlot *hash_map_next(HashMap *map, HashMapSlot *slot);
@@ -0,0 +1,122 @@
+#define STRING_MATCHER_ALPHABET 256
+
+StringMatcher string_matcher_build(Arena *arena, StringList *patterns)
+{
+    // NOTE(cya): one state per pattern byte at most, plus the root
+    u32 cap = (u32)patterns->total_len + 1;
+    StringMatcher matcher = {
+        .next = arena_push_array(arena, (usize)cap * STRING_MATCHER_ALPHABET, u32),
+        .match = arena_push_array(arena, cap, u32),
+        .match_link = arena_push_array(arena, cap, u32),
+        .pattern_lens = arena_push_array(arena, patterns->node_count, u32),
+        .state_count = 1,
+    };
+    for (usize i = 0; i < (usize)cap * STRING_MATCHER_ALPHABET; i++) {
+        matcher.next[i] = 0;
+    }
+
+    for (u32 i = 0; i < cap; i++) {
+        matcher.match[i] = 0;
+        matcher.match_link[i] = 0;
+    }
+
+    // NOTE(cya): the trie first; the root is never a child, so 0 doubles as
+    // "no edge" until the failure pass fills those in
+    string_list_foreach(patterns, node) {
+        String pattern = node->str;
+        u32 index = matcher.pattern_count++;
+        matcher.pattern_lens[index] = (u32)pattern.len;
+        if (string_is_empty(pattern)) {
+            continue;
+        }
+
+        u32 state = 0;
+        for (usize i = 0; i < pattern.len; i++) {
+            u32 *edge = &matcher.next[state * STRING_MATCHER_ALPHABET + pattern.str[i]];
+            if (*edge == 0) {
+                *edge = matcher.state_count++;
+            }
+
+            state = *edge;
+        }
+
+        // NOTE(cya): duplicates report the first one listed
+        if (matcher.match[state] == 0) {
+            matcher.match[state] = index + 1;
+        }
+    }
+
+    // NOTE(cya): breadth first, so a state's failure target (always shallower)
+    // is complete by the time it's copied from
+    u32 *fail = arena_push_array(arena, matcher.state_count, u32);
+    u32 *queue = arena_push_array(arena, matcher.state_count, u32);
+    u32 head = 0, tail = 0;
+    for (u32 c = 0; c < STRING_MATCHER_ALPHABET; c++) {
+        u32 child = matcher.next[c];
+        if (child != 0) {
+            fail[child] = 0;
+            queue[tail++] = child;
+        }
+    }
+
+    while (head < tail) {
+        u32 state = queue[head++];
+        u32 fallback = fail[state];
+        matcher.match_link[state] = matcher.match[fallback] != 0 ?
+            fallback : matcher.match_link[fallback];
+        for (u32 c = 0; c < STRING_MATCHER_ALPHABET; c++) {
+            u32 *edge = &matcher.next[state * STRING_MATCHER_ALPHABET + c];
+            u32 fallback_edge = matcher.next[fallback * STRING_MATCHER_ALPHABET + c];
+            if (*edge == 0) {
+                *edge = fallback_edge;
+            } else {
+                fail[*edge] = fallback_edge;
+                queue[tail++] = *edge;
+            }
+        }
+    }
+
+    return matcher;
+}
+
+// NOTE(cya): letters and digits; anything else separates words
+internal inline b32 string_matcher_is_word_byte(u8 c)
+{
+    return char_is_digit((char)c) || ((u8)((c | 0x20) - 'a') < 26);
+}
+
+// NOTE(cya): the first match (by where it ends) that isn't glued to a letter
+// or digit on either side, so `jdk-1` is never found in `jdk-17`
+b32 string_matcher_find_word(StringMatcher *matcher, String s, StringMatch *out)
+{
+    u32 state = 0;
+    for (usize i = 0; i < s.len; i++) {
+        state = matcher->next[state * STRING_MATCHER_ALPHABET + s.str[i]];
+        u32 candidate = matcher->match[state] != 0 ? state : matcher->match_link[state];
+        for (; candidate != 0; candidate = matcher->match_link[candidate]) {
+            u32 pattern = matcher->match[candidate] - 1;
+            usize len = matcher->pattern_lens[pattern];
+            usize start = i + 1 - len;
+            b32 is_word = (start == 0 || !string_matcher_is_word_byte(s.str[start - 1])) &&
+                (i + 1 == s.len || !string_matcher_is_word_byte(s.str[i + 1]));
+            if (is_word) {
+                *out = (StringMatch){.pattern = pattern, .start = start, .len = len};
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+inline String string_array_find_first_word_match(StringArray *array, StringMatcher *matcher)
+{
+    StringMatch match;
+    for (usize i = 0; i < array->count; i++) {
+        if (string_matcher_find_word(matcher, array->items[i], &match)) {
+            return array->items[i];
+        }
+    }
+
+    return string_lit("");
+}
@@ -0,0 +1,21 @@
+// NOTE(cya): Aho-Corasick automaton over a fixed set of patterns; the goto
+// and failure functions are folded into one dense table, so scanning costs a
+// lookup per byte however many patterns there are
+typedef struct {
+    u32 *next; // NOTE(cya): state * 256 + byte -> state
+    u32 *match; // NOTE(cya): pattern ending at this state, plus one (0 = none)
+    u32 *match_link; // NOTE(cya): closest state down the failure chain with a match
+    u32 *pattern_lens;
+    u32 state_count;
+    u32 pattern_count;
+} StringMatcher;
+
+typedef struct {
+    u32 pattern; // NOTE(cya): index into the list the matcher was built from
+    usize start;
+    usize len;
+} StringMatch;
+
+internal StringMatcher string_matcher_build(Arena *arena, StringList *patterns);
+internal b32 string_matcher_find_word(StringMatcher *matcher, String s, StringMatch *out);
+internal String string_array_find_first_word_match(StringArray *array, StringMatcher *matcher);
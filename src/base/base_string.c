@@ -6,6 +6,13 @@ inline char *string_to_cstring(Arena *arena, String s)
     return result;
 }
 
+inline String string_copy(Arena *arena, String s)
+{
+    u8 *result = arena_push(arena, s.len);
+    mem_copy(result, s.str, s.len);
+    return string_create(result, s.len);
+}
+
 inline b32 string_starts_with(String a, String b)
 {
     if (b.len > a.len) {
@@ -21,17 +28,143 @@ inline b32 string_starts_with(String a, String b)
     return true;
 }
 
-inline b32 string_contains(String haystack, String needle)
+inline b32 string_ends_with(String a, String b)
 {
-    for (usize i = 0; i < haystack.len; i++) {
-        b32 found_match = haystack.str[i] == needle.str[0] &&
-            mem_equal(&haystack.str[i], needle.str, needle.len);
-        if (found_match) {
-            return true;
+    if (b.len > a.len) {
+        return false;
+    }
+
+    return mem_equal(&a.str[a.len - b.len], b.str, b.len);
+}
+
+// NOTE(cya): first/last byte filter: a block of candidate positions is
+// compared against the needle's first and last bytes at once, only the
+// positions where both match get the full comparison. The kernels stop where
+// a block would read past the haystack and leave the rest to the scalar loop
+internal inline b32 string_find_verify(u8 *candidate, String needle)
+{
+    return needle.len < 3 || mem_equal(&candidate[1], &needle.str[1], needle.len - 2);
+}
+
+internal usize string_find_scalar(String haystack, String needle, usize from)
+{
+    u8 first = needle.str[0];
+    for (usize i = from; i + needle.len <= haystack.len; i++) {
+        if (haystack.str[i] == first && mem_equal(&haystack.str[i], needle.str, needle.len)) {
+            return i;
         }
     }
 
-    return false;
+    return haystack.len;
+}
+
+#if defined(ARCH_X64)
+target_avx2 internal usize string_find_avx2(String haystack, String needle, usize *from)
+{
+    u8 *str = haystack.str;
+    usize last = needle.len - 1;
+    __m256i first_256 = _mm256_set1_epi8((char)needle.str[0]);
+    __m256i last_256 = _mm256_set1_epi8((char)needle.str[last]);
+    usize i = *from;
+    for (; i + last + 32 <= haystack.len; i += 32) {
+        __m256i block_first = _mm256_loadu_si256((const __m256i*)&str[i]);
+        __m256i block_last = _mm256_loadu_si256((const __m256i*)&str[i + last]);
+        __m256i eq = _mm256_and_si256(
+            _mm256_cmpeq_epi8(block_first, first_256),
+            _mm256_cmpeq_epi8(block_last, last_256)
+        );
+        for (u32 mask = (u32)_mm256_movemask_epi8(eq); mask != 0; mask &= mask - 1) {
+            usize pos = i + count_trailing_zeros_u32(mask);
+            if (string_find_verify(&str[pos], needle)) {
+                return pos;
+            }
+        }
+    }
+
+    *from = i;
+    return haystack.len;
+}
+
+internal usize string_find_sse2(String haystack, String needle, usize *from)
+{
+    u8 *str = haystack.str;
+    usize last = needle.len - 1;
+    __m128i first_128 = _mm_set1_epi8((char)needle.str[0]);
+    __m128i last_128 = _mm_set1_epi8((char)needle.str[last]);
+    usize i = *from;
+    for (; i + last + 16 <= haystack.len; i += 16) {
+        __m128i block_first = _mm_loadu_si128((const __m128i*)&str[i]);
+        __m128i block_last = _mm_loadu_si128((const __m128i*)&str[i + last]);
+        __m128i eq = _mm_and_si128(
+            _mm_cmpeq_epi8(block_first, first_128),
+            _mm_cmpeq_epi8(block_last, last_128)
+        );
+        for (u32 mask = (u32)_mm_movemask_epi8(eq); mask != 0; mask &= mask - 1) {
+            usize pos = i + count_trailing_zeros_u32(mask);
+            if (string_find_verify(&str[pos], needle)) {
+                return pos;
+            }
+        }
+    }
+
+    *from = i;
+    return haystack.len;
+}
+#elif defined(ARCH_ARM64)
+internal usize string_find_neon(String haystack, String needle, usize *from)
+{
+    u8 *str = haystack.str;
+    usize last = needle.len - 1;
+    uint8x16_t first_128 = vdupq_n_u8(needle.str[0]);
+    uint8x16_t last_128 = vdupq_n_u8(needle.str[last]);
+    usize i = *from;
+    for (; i + last + 16 <= haystack.len; i += 16) {
+        uint8x16_t eq = vandq_u8(
+            vceqq_u8(vld1q_u8(&str[i]), first_128),
+            vceqq_u8(vld1q_u8(&str[i + last]), last_128)
+        );
+        // NOTE(cya): no movemask on NEON, narrow to 4 bits per byte instead
+        uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+        u64 mask = vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+        for (; mask != 0; mask &= ~((u64)0xF << (count_trailing_zeros_u64(mask) & ~3u))) {
+            usize pos = i + count_trailing_zeros_u64(mask) / 4;
+            if (string_find_verify(&str[pos], needle)) {
+                return pos;
+            }
+        }
+    }
+
+    *from = i;
+    return haystack.len;
+}
+#endif
+
+// NOTE(cya): index of the first `needle` at or after `from`, or `haystack.len`
+usize string_find(String haystack, String needle, usize from)
+{
+    if (needle.len == 0 || from + needle.len > haystack.len) {
+        return needle.len == 0 ? min(from, haystack.len) : haystack.len;
+    }
+
+    usize i = from;
+    usize found = haystack.len;
+#if defined(ARCH_X64)
+    if (cpu_features.has_avx2) {
+        found = string_find_avx2(haystack, needle, &i);
+    }
+
+    if (found == haystack.len) {
+        found = string_find_sse2(haystack, needle, &i);
+    }
+#elif defined(ARCH_ARM64)
+    found = string_find_neon(haystack, needle, &i);
+#endif
+    return found < haystack.len ? found : string_find_scalar(haystack, needle, i);
+}
+
+inline b32 string_contains(String haystack, String needle)
+{
+    return needle.len == 0 || string_find(haystack, needle, 0) < haystack.len;
 }
 
 inline String string_keep_number(String s)
@@ -45,6 +178,141 @@ inline String string_keep_number(String s)
     return string_create(&s.str[i], j - i);
 }
 
+readonly global char __HEX_DIGITS[] = "0123456789abcdef";
+readonly global u8 __SYMBOL_FROM_U8[10] = {
+    [0] = 48, [1] = 49, [2] = 50, [3] = 51, [4] = 52,
+    [5] = 53, [6] = 54, [7] = 55, [8] = 56, [9] = 57
+};
+readonly global u8 __U8_FROM_SYMBOL[128] = {
+    [48] = 0x00, [49] = 0x01, [50] = 0x02, [51] = 0x03, [52] = 0x04,
+    [53] = 0x05, [54] = 0x06, [55] = 0x07, [56] = 0x08, [57] = 0x09,
+};
+
+// NOTE(cya): copies what fits and always advances, so a pass with no room
+// at all measures the output
+internal inline void string_fmt_put(u8 *buf, usize cap, usize *pos, const void *src, usize len)
+{
+    if (*pos < cap) {
+        mem_copy(&buf[*pos], src, min(len, cap - *pos));
+    }
+
+    *pos += len;
+}
+
+internal inline usize string_fmt_u64_digits(u8 *out, u64 val)
+{
+    u8 digits[20];
+    usize len = 0;
+    do {
+        digits[sizeof(digits) - ++len] = __SYMBOL_FROM_U8[val % 10];
+        val /= 10;
+    } while (val != 0);
+
+    mem_copy(out, &digits[sizeof(digits) - len], len);
+    return len;
+}
+
+// NOTE(cya): whole units when exact, one (truncated) decimal otherwise
+internal usize string_fmt_scaled(u8 *out, u64 val, u64 unit, const char *suffix)
+{
+    usize len = string_fmt_u64_digits(out, val / unit);
+    u64 tenths = (val % unit) * 10 / unit;
+    if (val % unit != 0) {
+        out[len++] = '.';
+        out[len++] = __SYMBOL_FROM_U8[tenths];
+    }
+
+    for (; *suffix != '\0'; suffix++) {
+        out[len++] = (u8)*suffix;
+    }
+
+    return len;
+}
+
+internal usize string_fmt_size(u8 *out, u64 bytes)
+{
+    if (bytes < kibibytes(1)) {
+        return string_fmt_scaled(out, bytes, 1, "B");
+    } else if (bytes < mebibytes(1)) {
+        return string_fmt_scaled(out, bytes, kibibytes(1), "KiB");
+    } else if (bytes < gibibytes(1)) {
+        return string_fmt_scaled(out, bytes, mebibytes(1), "MiB");
+    }
+
+    return string_fmt_scaled(out, bytes, gibibytes(1), "GiB");
+}
+
+internal usize string_fmt_duration(u8 *out, u64 ns)
+{
+    if (ns < 1000) {
+        return string_fmt_scaled(out, ns, 1, "ns");
+    } else if (ns < 1000 * 1000) {
+        return string_fmt_scaled(out, ns, 1000, "us");
+    } else if (ns < 1000 * 1000 * 1000) {
+        return string_fmt_scaled(out, ns, 1000 * 1000, "ms");
+    }
+
+    return string_fmt_scaled(out, ns, 1000 * 1000 * 1000, "s");
+}
+
+// NOTE(cya): `{}` takes a String; `{u}`, `{i}` take u64/i64, `{x}` a u64 as 16
+// hex digits, `{size}` a byte count and `{ns}` a duration in nanoseconds. The
+// numeric ones read 64-bit varargs, narrower values have to be cast. Returns
+// the full length even when `cap` cuts the output short
+internal usize string_fmt_write(u8 *buf, usize cap, const char *fmt, va_list va)
+{
+    usize pos = 0;
+    usize cur = 0, i = 0;
+    for (; fmt[i] != '\0'; i++) {
+        if (fmt[i] != '{' || (i > 0 && fmt[i - 1] == '\\')) {
+            continue;
+        }
+
+        usize end = i + 1;
+        for (; fmt[end] != '\0' && fmt[end] != '}' && end - i <= 5; end++) {}
+        if (fmt[end] != '}') {
+            continue;
+        }
+
+        String spec = string_create(&fmt[i + 1], end - i - 1);
+        u8 scratch[32];
+        String value;
+        if (string_is_empty(spec)) {
+            value = va_arg(va, String);
+        } else if (string_equals(spec, string_lit("u"))) {
+            value = string_create(scratch, string_fmt_u64_digits(scratch, va_arg(va, u64)));
+        } else if (string_equals(spec, string_lit("i"))) {
+            i64 val = va_arg(va, i64);
+            scratch[0] = '-';
+            usize sign = val < 0;
+            u64 magnitude = val < 0 ? (u64)0 - (u64)val : (u64)val;
+            value = string_create(scratch, sign + string_fmt_u64_digits(&scratch[sign], magnitude));
+        } else if (string_equals(spec, string_lit("x"))) {
+            u64 val = va_arg(va, u64);
+            for (usize digit = 0; digit < 16; digit++) {
+                scratch[digit] = __HEX_DIGITS[(val >> (60 - 4 * digit)) & 0xF];
+            }
+
+            value = string_create(scratch, 16);
+        } else if (string_equals(spec, string_lit("size"))) {
+            value = string_create(scratch, string_fmt_size(scratch, va_arg(va, u64)));
+        } else if (string_equals(spec, string_lit("ns"))) {
+            value = string_create(scratch, string_fmt_duration(scratch, va_arg(va, u64)));
+        } else {
+            // NOTE(cya): not a placeholder, left as written
+            continue;
+        }
+
+        string_fmt_put(buf, cap, &pos, &fmt[cur], i - cur);
+        string_fmt_put(buf, cap, &pos, value.str, value.len);
+        cur = end + 1;
+        i = end;
+    }
+
+    string_fmt_put(buf, cap, &pos, &fmt[cur], i - cur);
+    return pos;
+}
+
 inline String string_fmt(Arena *arena, const char *fmt, ...)
 {
     va_list va;
@@ -54,30 +322,35 @@ inline String string_fmt(Arena *arena, const char *fmt, ...)
     return str;
 }
 
-inline String string_fmt_va(Arena *arena, const char *fmt, va_list va)
+// NOTE(cya): measured first, then written into one exact-size allocation
+String string_fmt_va(Arena *arena, const char *fmt, va_list va)
 {
-    StringList parts = {0};
-    usize cur = 0, i = 0;
-    for (; fmt[i] != '\0'; i++) {
-        if (fmt[i] == '{' && fmt[i + 1] == '}') {
-            if (i > 0 && fmt[i - 1] == '\\') {
-                continue;
-            }
-
-            usize len = i - cur;
-            if (len > 0) {
-                string_list_push_back(arena, &parts, string_create(&fmt[cur], len));
-            }
+    va_list measure;
+    va_copy(measure, va);
+    usize len = string_fmt_write(NULL, 0, fmt, measure);
+    va_end(measure);
 
-            string_list_push_back(arena, &parts, va_arg(va, String));
+    u8 *buf = arena_push(arena, len + 1);
+    string_fmt_write(buf, len, fmt, va);
+    buf[len] = '\0';
+    return string_create(buf, len);
+}
 
-            cur += len + 2;
-            i += 1;
-        }
-    }
+inline String string_fmt_buf(u8 *buf, usize cap, const char *fmt, ...)
+{
+    va_list va;
+    va_start(va, fmt);
+    String str = string_fmt_buf_va(buf, cap, fmt, va);
+    va_end(va);
+    return str;
+}
 
-    string_list_push_back(arena, &parts, string_create(&fmt[cur], i - cur));
-    return string_list_join(arena, &parts, string_lit(""));
+// NOTE(cya): no allocation; output that doesn't fit `cap` is cut off, the
+// result is whatever made it in
+inline String string_fmt_buf_va(u8 *buf, usize cap, const char *fmt, va_list va)
+{
+    usize len = string_fmt_write(buf, cap, fmt, va);
+    return string_create(buf, min(len, cap));
 }
 
 String string_skip_first_match(String s, String target)
@@ -88,19 +361,21 @@ String string_skip_first_match(String s, String target)
 String string_skip_nth_match(String s, String target, usize n)
 {
     usize matches = 0;
-    usize len = s.len;
     usize i = 0;
-    for (; i < len; i++) {
-        if (mem_equal(&s.str[i], target.str, target.len)) {
-            matches += 1;
-            i += target.len;
-            if (matches == n) {
-                break;
-            }
+    while (target.len > 0 && i < s.len) {
+        i = string_find(s, target, i);
+        if (i == s.len) {
+            break;
+        }
+
+        matches += 1;
+        i += target.len;
+        if (matches == n) {
+            return string_create(&s.str[i], s.len - i);
         }
     }
 
-    return string_create(&s.str[i], len - i);
+    return string_create(&s.str[s.len], 0);
 }
 
 b32 string_contains_whitespace(String s)
@@ -149,7 +424,7 @@ inline String string_trim_trailing(String s)
         i -= 1;
     }
 
-    return string_create(s.str, i);
+    return string_create(s.str, i + 1);
 }
 
 inline String string_path_append(Arena *arena, String path, String elem)
@@ -160,36 +435,33 @@ inline String string_path_append(Arena *arena, String path, String elem)
 
 inline String string_path_get_last_element(String path)
 {
-    for (usize i = 0; i < path.len; i++) {
-        usize index = path.len - i - 1;
-        if (PLATFORM_PATH_SEPARATOR[0] == path.str[index]) {
-            return string_create(&path.str[index + 1], i);
-        }
+    StringPathIter iter = string_path_iter_reverse(path);
+    String elem = {0};
+    if (!string_path_next(&iter, &elem) || elem.str == path.str) {
+        // NOTE(cya): a bare name has no separator to split on
+        return string_lit("");
     }
 
-    return string_lit("");
+    return elem;
 }
 
 inline String string_path_pop_element(String path)
 {
-    for (usize i = 0; i < path.len; i++) {
-        usize index = path.len - i - 1;
-        if (PLATFORM_PATH_SEPARATOR[0] == path.str[index]) {
-            return string_create(path.str, index);
-        }
+    StringPathIter iter = string_path_iter_reverse(path);
+    String elem = {0};
+    if (!string_path_next(&iter, &elem) || elem.str == path.str) {
+        return string_lit("");
     }
 
-    return string_lit("");
-}
+    // NOTE(cya): drop the separators before the element too, a root like "/a"
+    // pops down to "" the same way it always has
+    usize len = elem.str - path.str;
+    while (len > 0 && path.str[len - 1] == PLATFORM_PATH_SEPARATOR[0]) {
+        len -= 1;
+    }
 
-readonly global u8 __SYMBOL_FROM_U8[10] = {
-    [0] = 48, [1] = 49, [2] = 50, [3] = 51, [4] = 52,
-    [5] = 53, [6] = 54, [7] = 55, [8] = 56, [9] = 57
-};
-readonly global u8 __U8_FROM_SYMBOL[128] = {
-    [48] = 0x00, [49] = 0x01, [50] = 0x02, [51] = 0x03, [52] = 0x04,
-    [53] = 0x05, [54] = 0x06, [55] = 0x07, [56] = 0x08, [57] = 0x09,
-};
+    return string_create(path.str, len);
+}
 
 thread_local u8 __u64_buffer[20 + 1];
 
@@ -228,35 +500,125 @@ inline StringNode *string_node_create(Arena *arena, String s)
     return result;
 }
 
-StringList string_split(Arena *arena, String s, String delims)
+inline StringList string_split(Arena *arena, String s, String delims)
 {
     StringList result = {0};
-    u8 *base, *str;
-    base = str = s.str;
-    for (usize i = 0; i < s.len; i++) {
-        if (i == s.len - 1 || string_contains_char(delims, str[i])) {
-            String elem = string_create(base, i - (base - str));
-            string_list_push_back(arena, &result, elem);
-            base = &str[i + 1];
-        }
+    StringSplitIter iter = string_split_iter(s, delims);
+    String elem;
+    while (string_split_next(&iter, &elem)) {
+        string_list_push_back(arena, &result, elem);
     }
 
     return result;
 }
 
-inline char **string_list_to_cstrings(Arena *arena, StringList *list, int *out_len)
+inline StringSplitIter string_split_iter(String s, String delims)
 {
-    usize len = list->node_count;
-    char **result = arena_push_array(arena, len + 1, char*);
-    usize i = 0;
-    string_list_foreach(list, node) {
-        String str = node->str;
-        result[i++] = string_to_cstring(arena, str);
+    return (StringSplitIter){
+        .s = s,
+        .delims = delims,
+        .is_done = string_is_empty(s),
+    };
+}
+
+// NOTE(cya): empty elements are kept, including a trailing one after a final
+// delimiter, since an empty PATH entry still means the working directory
+b32 string_split_next(StringSplitIter *iter, String *elem)
+{
+    if (iter->is_done) {
+        return false;
     }
 
-    *out_len = len;
-    result[len] = NULL;
-    return result;
+    usize start = iter->pos;
+    usize i = start;
+    while (i < iter->s.len && !string_contains_char(iter->delims, iter->s.str[i])) {
+        i += 1;
+    }
+
+    *elem = string_create(&iter->s.str[start], i - start);
+    iter->is_done = i == iter->s.len;
+    iter->pos = i + 1;
+    return true;
+}
+
+inline StringPathIter string_path_iter(String path)
+{
+    return (StringPathIter){.path = path};
+}
+
+inline StringPathIter string_path_iter_reverse(String path)
+{
+    return (StringPathIter){.path = path, .pos = path.len, .is_reverse = true};
+}
+
+// NOTE(cya): repeated and trailing separators never produce empty elements
+b32 string_path_next(StringPathIter *iter, String *elem)
+{
+    u8 sep = PLATFORM_PATH_SEPARATOR[0];
+    u8 *str = iter->path.str;
+    if (iter->is_reverse) {
+        usize end = iter->pos;
+        while (end > 0 && str[end - 1] == sep) {
+            end -= 1;
+        }
+
+        usize start = end;
+        while (start > 0 && str[start - 1] != sep) {
+            start -= 1;
+        }
+
+        iter->pos = start;
+        if (start == end) {
+            return false;
+        }
+
+        *elem = string_create(&str[start], end - start);
+        return true;
+    }
+
+    usize start = iter->pos;
+    while (start < iter->path.len && str[start] == sep) {
+        start += 1;
+    }
+
+    usize end = start;
+    while (end < iter->path.len && str[end] != sep) {
+        end += 1;
+    }
+
+    iter->pos = end;
+    if (start == end) {
+        return false;
+    }
+
+    *elem = string_create(&str[start], end - start);
+    return true;
+}
+
+inline StringLineIter string_line_iter(String s)
+{
+    return (StringLineIter){.s = s};
+}
+
+// NOTE(cya): '\r' is stripped from "\r\n" endings, `pos` is left right after
+// the line so callers streaming through a window know how much was consumed
+b32 string_line_next(StringLineIter *iter, String *line)
+{
+    if (iter->pos >= iter->s.len) {
+        return false;
+    }
+
+    String rest = string_cut_leading(iter->s, iter->pos);
+    usize len = string_find(rest, string_lit("\n"), 0);
+    iter->is_terminated = len < rest.len;
+    iter->pos += len + iter->is_terminated;
+
+    if (len > 0 && rest.str[len - 1] == '\r') {
+        len -= 1;
+    }
+
+    *line = string_create(rest.str, len);
+    return true;
 }
 
 inline void string_list_push_node_back(StringList *list, StringNode *node)
@@ -315,27 +677,6 @@ inline String string_list_find_first_match(StringList *list, StringList *needles
     return string_lit("");
 }
 
-inline void string_list_pop_matches(StringList *list, String needle)
-{
-    StringNode *prev = NULL;
-    string_list_foreach(list, node) {
-        String str = node->str;
-        if (string_contains(str, needle)) {
-            list->node_count -= 1;
-            if (node == list->first) {
-                sll_queue_pop_front(list->first, list->last);
-            } else {
-                prev->next = node->next;
-                if (node == list->last) {
-                    list->last = prev;
-                }
-            }
-        }
-
-        prev = node;
-    }
-}
-
 String string_list_join(Arena *arena, StringList *list, String delim)
 {
     if (list->node_count == 0) {
@@ -359,3 +700,193 @@ String string_list_join(Arena *arena, StringList *list, String delim)
 
     return string_create(buf, total_len);
 }
+
+// NOTE(cya): byte-wise, a prefix sorts first
+i32 string_compare(String a, String b)
+{
+    usize len = min(a.len, b.len);
+    for (usize i = 0; i < len; i++) {
+        if (a.str[i] != b.str[i]) {
+            return a.str[i] < b.str[i] ? -1 : 1;
+        }
+    }
+
+    return a.len == b.len ? 0 : (a.len < b.len ? -1 : 1);
+}
+
+inline StringArray string_array_init(Arena *arena, usize cap)
+{
+    return (StringArray){
+        .items = arena_push_array(arena, cap, String),
+        .cap = cap,
+    };
+}
+
+// NOTE(cya): doubles into a fresh block when full, the old one is left to the
+// arena
+inline void string_array_push(Arena *arena, StringArray *array, String s)
+{
+    if (array->count == array->cap) {
+        usize cap = max(array->cap * 2, 16);
+        String *items = arena_push_array(arena, cap, String);
+        if (array->count > 0) {
+            mem_copy(items, array->items, array->count * sizeof(String));
+        }
+
+        array->items = items;
+        array->cap = cap;
+    }
+
+    array->items[array->count++] = s;
+}
+
+void string_array_push_list(Arena *arena, StringArray *array, StringList *list)
+{
+    usize needed = array->count + list->node_count;
+    if (needed > array->cap) {
+        String *items = arena_push_array(arena, needed, String);
+        if (array->count > 0) {
+            mem_copy(items, array->items, array->count * sizeof(String));
+        }
+
+        array->items = items;
+        array->cap = needed;
+    }
+
+    string_list_foreach(list, node) {
+        array->items[array->count++] = node->str;
+    }
+}
+
+inline StringArray string_array_from_list(Arena *arena, StringList *list)
+{
+    StringArray array = string_array_init(arena, list->node_count);
+    string_array_push_list(arena, &array, list);
+    return array;
+}
+
+inline StringArray string_array_from_cstrings(Arena *arena, char **cstrings, usize count)
+{
+    StringArray array = string_array_init(arena, count);
+    for (usize i = 0; i < count; i++) {
+        array.items[i] = string_from_cstring(cstrings[i]);
+    }
+
+    array.count = count;
+    return array;
+}
+
+// NOTE(cya): the nodes come out of one block, linked in array order
+StringList string_array_to_list(Arena *arena, StringArray *array)
+{
+    StringList list = {0};
+    StringNode *nodes = arena_push_array(arena, array->count, StringNode);
+    for (usize i = 0; i < array->count; i++) {
+        nodes[i].str = array->items[i];
+        string_list_push_node_back(&list, &nodes[i]);
+    }
+
+    return list;
+}
+
+// NOTE(cya): NULL-terminated; views aren't guaranteed to be, so each one is
+// copied out
+char **string_array_to_cstrings(Arena *arena, StringArray *array)
+{
+    char **result = arena_push_array(arena, array->count + 1, char*);
+    for (usize i = 0; i < array->count; i++) {
+        result[i] = string_to_cstring(arena, array->items[i]);
+    }
+
+    result[array->count] = NULL;
+    return result;
+}
+
+// NOTE(cya): stable merge sort of positions into `items`
+internal void string_array_sort_indices(Arena *arena, String *items, usize *order, usize count)
+{
+    usize *scratch = arena_push_array(arena, count, usize);
+    for (usize width = 1; width < count; width *= 2) {
+        for (usize lo = 0; lo < count; lo += 2 * width) {
+            usize mid = min(lo + width, count);
+            usize hi = min(lo + 2 * width, count);
+            usize i = lo, j = mid, k = lo;
+            while (i < mid && j < hi) {
+                b32 take_right = string_compare(items[order[j]], items[order[i]]) < 0;
+                scratch[k++] = take_right ? order[j++] : order[i++];
+            }
+
+            while (i < mid) {
+                scratch[k++] = order[i++];
+            }
+
+            while (j < hi) {
+                scratch[k++] = order[j++];
+            }
+        }
+
+        mem_copy(order, scratch, count * sizeof(usize));
+    }
+}
+
+inline void string_array_sort(Arena *arena, StringArray *array)
+{
+    usize count = array->count;
+    if (count < 2) {
+        return;
+    }
+
+    usize *order = arena_push_array(arena, count, usize);
+    for (usize i = 0; i < count; i++) {
+        order[i] = i;
+    }
+
+    string_array_sort_indices(arena, array->items, order, count);
+
+    String *sorted = arena_push_array(arena, count, String);
+    for (usize i = 0; i < count; i++) {
+        sorted[i] = array->items[order[i]];
+    }
+
+    mem_copy(array->items, sorted, count * sizeof(String));
+}
+
+// NOTE(cya): keeps the first of each set of equal strings, in their original
+// order
+void string_array_dedup(Arena *arena, StringArray *array)
+{
+    if (array->count < 2) {
+        return;
+    }
+
+    HashMap seen = hash_map_init(arena, array->count);
+    usize kept = 0;
+    for (usize i = 0; i < array->count; i++) {
+        if (hash_map_insert(&seen, array->items[i], 0)) {
+            array->items[kept++] = array->items[i];
+        }
+    }
+
+    array->count = kept;
+}
+
+// NOTE(cya): binary search over a sorted array, `count` when it's not there
+inline usize string_array_find(StringArray *array, String s)
+{
+    usize lo = 0, hi = array->count;
+    while (lo < hi) {
+        usize mid = lo + (hi - lo) / 2;
+        i32 order = string_compare(array->items[mid], s);
+        if (order == 0) {
+            return mid;
+        }
+
+        if (order < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    return array->count;
+}
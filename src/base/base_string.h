@@ -20,6 +20,34 @@ typedef struct {
     StringNode *last;
 } StringList;
 
+// NOTE(cya): contiguous views, the bytes themselves aren't copied in or out
+typedef struct {
+    String *items;
+    usize count;
+    usize cap;
+} StringArray;
+
+// NOTE(cya): the iterators below live on the stack and hand out views into
+// the source string, so walking one never touches an arena
+typedef struct {
+    String s;
+    String delims;
+    usize pos;
+    b32 is_done;
+} StringSplitIter;
+
+typedef struct {
+    String path;
+    usize pos; // NOTE(cya): forward: next byte to read, reverse: end of the rest
+    b32 is_reverse;
+} StringPathIter;
+
+typedef struct {
+    String s;
+    usize pos;
+    b32 is_terminated; // NOTE(cya): last line handed out ended in '\n'
+} StringLineIter;
+
 #define string_is_empty(s) ((s).len == 0)
 #define string_lit(s) string_create((s), sizeof(s) - 1)
 #define string_contains_char(s, c) string_contains((s), string_create(&(c), 1))
@@ -35,12 +63,17 @@ typedef struct {
     for (StringNode *(n) = (l)->first; (n) != NULL; (n) = (n)->next)
 
 internal char *string_to_cstring(Arena *arena, String s);
+internal String string_copy(Arena *arena, String s);
 
 internal b32 string_starts_with(String a, String b);
+internal b32 string_ends_with(String a, String b);
+internal usize string_find(String haystack, String needle, usize from);
 internal b32 string_contains(String haystack, String needle);
 internal String string_keep_number(String s);
 internal String string_fmt(Arena *arena, const char *fmt, ...);
 internal String string_fmt_va(Arena *arena, const char *fmt, va_list va);
+internal String string_fmt_buf(u8 *buf, usize cap, const char *fmt, ...);
+internal String string_fmt_buf_va(u8 *buf, usize cap, const char *fmt, va_list va);
 internal String string_list_find_first_match(StringList *list, StringList *needles);
 internal String string_skip_nth_match(String s, String target, usize n);
 internal String string_join(Arena *arena, String delim, String a, String b);
@@ -55,12 +88,30 @@ internal u64 string_parse_u64(String s);
 
 internal StringNode *string_node_create(Arena *arena, String s);
 internal StringList string_split(Arena *arena, String s, String delims);
-internal char **string_list_to_cstrings(Arena *arena, StringList *list, int *out_len);
+
+internal StringSplitIter string_split_iter(String s, String delims);
+internal b32 string_split_next(StringSplitIter *iter, String *elem);
+internal StringPathIter string_path_iter(String path);
+internal StringPathIter string_path_iter_reverse(String path);
+internal b32 string_path_next(StringPathIter *iter, String *elem);
+internal StringLineIter string_line_iter(String s);
+internal b32 string_line_next(StringLineIter *iter, String *line);
 
 internal void string_list_push_node_back(StringList *list, StringNode *node);
 internal void string_list_push_node_front(StringList *list, StringNode *node);
 internal void string_list_push_back(Arena *arena, StringList *list, String s);
 internal void string_list_push_front(Arena *arena, StringList *list, String s);
 internal String string_list_pop_front(StringList *list);
-internal void string_list_pop_matches(StringList *list, String needle);
 internal String string_list_join(Arena *arena, StringList *list, String delim);
+
+internal i32 string_compare(String a, String b);
+internal StringArray string_array_init(Arena *arena, usize cap);
+internal void string_array_push(Arena *arena, StringArray *array, String s);
+internal void string_array_push_list(Arena *arena, StringArray *array, StringList *list);
+internal StringArray string_array_from_list(Arena *arena, StringList *list);
+internal StringArray string_array_from_cstrings(Arena *arena, char **cstrings, usize count);
+internal StringList string_array_to_list(Arena *arena, StringArray *array);
+internal char **string_array_to_cstrings(Arena *arena, StringArray *array);
+internal void string_array_sort(Arena *arena, StringArray *array);
+internal void string_array_dedup(Arena *arena, StringArray *array);
+internal usize string_array_find(StringArray *array, String s);
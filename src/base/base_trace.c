@@ -0,0 +1,118 @@
+readonly global char *TRACE_TRACK_NAMES[] = {"wrapper", "child processes"};
+
+// NOTE(cya): timestamps are written relative to this
+inline void trace_enable(void)
+{
+    trace.is_enabled = true;
+    trace.origin_ns = platform_get_time_ns();
+}
+
+inline TraceScope trace_begin(const char *name, TraceTrack track)
+{
+    if (!trace.is_enabled) {
+        return (TraceScope){.index = TRACE_NO_EVENT};
+    }
+
+    if (trace.count == TRACE_MAX_EVENTS) {
+        trace.dropped += 1;
+        return (TraceScope){.index = TRACE_NO_EVENT};
+    }
+
+    u32 index = trace.count++;
+    trace.events[index] = (TraceEvent){
+        .name = name,
+        .start_ns = platform_get_time_ns(),
+        .cycles = cpu_cycles(),
+        .track = track,
+    };
+    return (TraceScope){.index = index};
+}
+
+inline void trace_end(TraceScope scope)
+{
+    if (scope.index == TRACE_NO_EVENT) {
+        return;
+    }
+
+    TraceEvent *event = &trace.events[scope.index];
+    event->cycles = cpu_cycles() - event->cycles;
+    event->end_ns = platform_get_time_ns();
+}
+
+// NOTE(cya): for spans that end after the trace is written (a process we
+// exec into); viewers run a lone "B" event to the end of the trace
+inline void trace_leave_open(TraceScope scope)
+{
+    if (scope.index != TRACE_NO_EVENT) {
+        trace.events[scope.index].is_left_open = true;
+    }
+}
+
+// NOTE(cya): the format wants microseconds, the fraction keeps full precision
+internal String trace_fmt_us(Arena *arena, u64 ns)
+{
+    u64 fraction = ns % 1000;
+    u8 digits[3] = {
+        (u8)('0' + fraction / 100),
+        (u8)('0' + fraction / 10 % 10),
+        (u8)('0' + fraction % 10),
+    };
+    return string_fmt(arena, "{u}.{}", ns / 1000, string_create(digits, sizeof(digits)));
+}
+
+// NOTE(cya): spans still open (we're usually inside a couple when this runs)
+// end now, unless they were left open on purpose. Built in scratch, as with
+// the arena stats
+
+b32 trace_store(Arena *arena, String path)
+{
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    Arena *temp = scratch.arena;
+    u64 now = platform_get_time_ns();
+    u64 pid = platform_get_process_id();
+    StringList json = {0};
+    string_list_push_back(temp, &json, string_lit("{\"traceEvents\": ["));
+    for (usize track = 0; track < array_len(TRACE_TRACK_NAMES); track++) {
+        String name = string_from_cstring(TRACE_TRACK_NAMES[track]);
+        const char *fmt =
+            "{}\n  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": {u}, \"tid\": {u}, "
+            "\"args\": {\"name\": \"{}\"}}";
+        String separator = track == 0 ? string_lit("") : string_lit(",");
+        string_list_push_back(temp, &json, string_fmt(temp, fmt, separator, pid, (u64)track, name));
+    }
+
+    for (u32 i = 0; i < trace.count; i++) {
+        TraceEvent *event = &trace.events[i];
+        String name = string_from_cstring(event->name);
+        String ts = trace_fmt_us(temp, event->start_ns - trace.origin_ns);
+        if (event->is_left_open) {
+            const char *fmt =
+                ",\n  {\"name\": \"{}\", \"ph\": \"B\", \"pid\": {u}, \"tid\": {u}, \"ts\": {}}";
+            String line = string_fmt(temp, fmt, name, pid, (u64)event->track, ts);
+            string_list_push_back(temp, &json, line);
+            continue;
+        }
+
+        u64 end_ns = event->end_ns == 0 ? now : event->end_ns;
+        String dur = trace_fmt_us(temp, end_ns - event->start_ns);
+        String args = CPU_HAS_CYCLE_COUNTER && event->end_ns != 0 ?
+            string_fmt(temp, ", \"args\": {\"cycles\": {u}}", event->cycles) : string_lit("");
+        const char *fmt =
+            ",\n  {\"name\": \"{}\", \"ph\": \"X\", \"pid\": {u}, \"tid\": {u}, "
+            "\"ts\": {}, \"dur\": {}{}}";
+        String line = string_fmt(temp, fmt, name, pid, (u64)event->track, ts, dur, args);
+        string_list_push_back(temp, &json, line);
+    }
+
+    String footer = string_fmt(
+        temp,
+        "\n], \"displayTimeUnit\": \"ns\", \"otherData\": {\"dropped_events\": \"{u}\"}}\n",
+        (u64)trace.dropped
+    );
+    string_list_push_back(temp, &json, footer);
+
+    String data = string_list_join(temp, &json, string_lit(""));
+    b32 is_stored = platform_file_write_atomic(temp, path, data);
+    arena_scratch_end(scratch);
+    return is_stored;
+}
@@ -0,0 +1,40 @@
+// NOTE(cya): spans recorded in place while tracing is on and written out as
+// Chrome trace-event JSON (chrome://tracing, ui.perfetto.dev). Main thread only;
+// with tracing off, begin and end are a single branch
+#define TRACE_MAX_EVENTS 256
+#define TRACE_NO_EVENT 0xFFFFFFFFu
+
+typedef enum {
+    TRACE_TRACK_WRAPPER,
+    TRACE_TRACK_CHILD, // NOTE(cya): processes we start and wait on
+} TraceTrack;
+
+typedef struct {
+    const char *name;
+    u64 start_ns;
+    u64 end_ns; // NOTE(cya): 0 while the span is open
+    u64 cycles; // NOTE(cya): counter at the start, the span's length once ended
+    TraceTrack track;
+    b32 is_left_open; // NOTE(cya): outlives us, written without an end
+} TraceEvent;
+
+typedef struct {
+    b32 is_enabled;
+    u64 origin_ns;
+    u32 count;
+    u32 dropped; // NOTE(cya): spans past TRACE_MAX_EVENTS
+    TraceEvent events[TRACE_MAX_EVENTS];
+} Trace;
+
+typedef struct {
+    u32 index; // NOTE(cya): TRACE_NO_EVENT when nothing was recorded
+} TraceScope;
+
+global Trace trace;
+
+internal void trace_enable(void);
+internal TraceScope trace_begin(const char *name, TraceTrack track);
+internal void trace_end(TraceScope scope);
+internal void trace_leave_open(TraceScope scope);
+
+internal b32 trace_store(Arena *arena, String path);
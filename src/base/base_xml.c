@@ -0,0 +1,236 @@
+#if defined(ARCH_X64)
+target_avx2 internal usize xml_find_byte_avx2(String s, usize from, u8 byte)
+{
+    usize i = from;
+    __m256i needle = _mm256_set1_epi8((char)byte);
+    for (; i + 32 <= s.len; i += 32) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)&s.str[i]);
+        u32 mask = (u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle));
+        if (mask != 0) {
+            return i + count_trailing_zeros_u32(mask);
+        }
+    }
+
+    return i;
+}
+#endif
+
+// NOTE(cya): index of the first `byte` at or after `from`, or `s.len`
+usize xml_find_byte(String s, usize from, u8 byte)
+{
+    usize i = from;
+    u8 *str = s.str;
+    usize len = s.len;
+#if defined(ARCH_X64)
+    if (cpu_features.has_avx2) {
+        // NOTE(cya): stops short of the match, or of the last partial block
+        i = xml_find_byte_avx2(s, i, byte);
+        if (i < len && str[i] == byte) {
+            return i;
+        }
+    }
+
+    __m128i needle = _mm_set1_epi8((char)byte);
+    for (; i + 16 <= len; i += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)&str[i]);
+        u32 mask = (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+        if (mask != 0) {
+            return i + count_trailing_zeros_u32(mask);
+        }
+    }
+#elif defined(ARCH_ARM64)
+    uint8x16_t needle = vdupq_n_u8(byte);
+    for (; i + 16 <= len; i += 16) {
+        uint8x16_t eq = vceqq_u8(vld1q_u8(&str[i]), needle);
+        // NOTE(cya): no movemask on NEON, narrow to 4 bits per byte instead
+        uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+        u64 mask = vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+        if (mask != 0) {
+            return i + count_trailing_zeros_u64(mask) / 4;
+        }
+    }
+#endif
+    for (; i < len; i++) {
+        if (str[i] == byte) {
+            return i;
+        }
+    }
+
+    return len;
+}
+
+// NOTE(cya): `out` is set just past the first `terminator` at or after `from`
+internal b32 xml_skip_past(String s, usize from, String terminator, usize *out)
+{
+    usize i = from;
+    for (;;) {
+        i = xml_find_byte(s, i, terminator.str[0]);
+        if (i + terminator.len > s.len) {
+            *out = s.len;
+            return false;
+        }
+
+        if (mem_equal(&s.str[i], terminator.str, terminator.len)) {
+            *out = i + terminator.len;
+            return true;
+        }
+
+        i += 1;
+    }
+}
+
+internal inline b32 xml_is_name_end(u8 c)
+{
+    return char_is_whitespace(c) || c == '>' || c == '/';
+}
+
+// NOTE(cya): `>` can legally show up inside quoted attribute values
+internal usize xml_find_tag_end(String s, usize from)
+{
+    usize i = from;
+    while (i < s.len) {
+        i = xml_find_byte(s, i, '>');
+        usize quote = from;
+        for (; quote < i && s.str[quote] != '"' && s.str[quote] != '\''; quote++) {}
+
+        if (quote == i) {
+            return i;
+        }
+
+        usize closing = xml_find_byte(s, quote + 1, s.str[quote]);
+        if (closing >= s.len) {
+            return s.len;
+        }
+
+        from = closing + 1;
+        i = from;
+    }
+
+    return s.len;
+}
+
+// NOTE(cya): `data` continues where the previous window stopped being
+// consumed, i.e. at `pos`
+inline void xml_scanner_refill(XmlScanner *scanner, String data, b32 is_partial)
+{
+    scanner->data = data;
+    scanner->pos = 0;
+    scanner->is_partial = is_partial;
+    scanner->needs_more = false;
+}
+
+// NOTE(cya): true when the construct starting at `start` is cut off by the end
+// of a partial window, in which case it's left for the next one
+internal inline b32 xml_scanner_wait(XmlScanner *scanner, b32 complete, usize start)
+{
+    if (complete || !scanner->is_partial) {
+        return false;
+    }
+
+    scanner->pos = start;
+    scanner->needs_more = true;
+    return true;
+}
+
+b32 xml_next(XmlScanner *scanner, XmlToken *out)
+{
+    String s = scanner->data;
+    while (!scanner->failed && !scanner->needs_more && scanner->pos < s.len) {
+        usize start = scanner->pos;
+        if (s.str[start] != '<') {
+            usize end = xml_find_byte(s, start, '<');
+            if (xml_scanner_wait(scanner, end < s.len, start)) {
+                break;
+            }
+
+            scanner->pos = end;
+            *out = (XmlToken){
+                .kind = XML_TOKEN_TEXT,
+                .text = string_create(&s.str[start], end - start),
+            };
+            return true;
+        }
+
+        // NOTE(cya): too short to tell what this is yet
+        String rest = string_cut_leading(s, start);
+        if (xml_scanner_wait(scanner, rest.len >= 9, start)) {
+            break;
+        }
+
+        usize end;
+        if (string_starts_with(rest, string_lit("<!--"))) {
+            b32 found = xml_skip_past(s, start + 4, string_lit("-->"), &end);
+            if (!xml_scanner_wait(scanner, found, start)) {
+                scanner->pos = end;
+            }
+
+            continue;
+        }
+
+        if (string_starts_with(rest, string_lit("<![CDATA["))) {
+            usize content = start + 9;
+            b32 found = xml_skip_past(s, content, string_lit("]]>"), &end);
+            if (xml_scanner_wait(scanner, found, start)) {
+                break;
+            }
+
+            scanner->pos = end;
+            usize content_len = found ? end - content - 3 : end - content;
+            *out = (XmlToken){
+                .kind = XML_TOKEN_TEXT,
+                .text = string_create(&s.str[content], content_len),
+            };
+            return true;
+        }
+
+        if (string_starts_with(rest, string_lit("<?"))) {
+            b32 found = xml_skip_past(s, start + 2, string_lit("?>"), &end);
+            if (!xml_scanner_wait(scanner, found, start)) {
+                scanner->pos = end;
+            }
+
+            continue;
+        }
+
+        if (string_starts_with(rest, string_lit("<!"))) {
+            // NOTE(cya): doctypes (internal subsets aren't supported)
+            b32 found = xml_skip_past(s, start + 2, string_lit(">"), &end);
+            if (!xml_scanner_wait(scanner, found, start)) {
+                scanner->pos = end;
+            }
+
+            continue;
+        }
+
+        end = xml_find_tag_end(s, start + 1);
+        if (xml_scanner_wait(scanner, end < s.len, start)) {
+            break;
+        }
+
+        if (end >= s.len) {
+            scanner->failed = true;
+            break;
+        }
+
+        b32 is_close = s.str[start + 1] == '/';
+        usize name_start = start + (is_close ? 2 : 1);
+        usize name_end = name_start;
+        for (; name_end < end && !xml_is_name_end(s.str[name_end]); name_end++) {}
+
+        XmlTokenKind kind = is_close ? XML_TOKEN_CLOSE :
+            s.str[end - 1] == '/' ? XML_TOKEN_EMPTY : XML_TOKEN_OPEN;
+        scanner->pos = end + 1;
+        *out = (XmlToken){
+            .kind = kind,
+            .name = string_create(&s.str[name_start], name_end - name_start),
+        };
+        return true;
+    }
+
+    // NOTE(cya): ran out at a token boundary, there may still be more
+    if (!scanner->failed && scanner->is_partial && scanner->pos >= s.len) {
+        scanner->needs_more = true;
+    }
+
+    return false;
+}
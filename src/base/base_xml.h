@@ -0,0 +1,32 @@
+typedef enum {
+    XML_TOKEN_OPEN, // NOTE(cya): `<name attr="...">`
+    XML_TOKEN_CLOSE, // NOTE(cya): `</name>`
+    XML_TOKEN_EMPTY, // NOTE(cya): `<name/>`
+    XML_TOKEN_TEXT, // NOTE(cya): character data and CDATA contents (raw)
+} XmlTokenKind;
+
+typedef struct {
+    XmlTokenKind kind;
+    String name;
+    String text;
+} XmlToken;
+
+// NOTE(cya): a non-validating pull tokenizer, good enough for poms: comments,
+// processing instructions, doctypes and attributes are skipped and entities
+// are left undecoded; when `data` is only a window over the document
+// (`is_partial`), a token cut off by its end isn't returned and `needs_more`
+// is set instead, with `pos` left at the token's start
+typedef struct {
+    String data;
+    usize pos;
+    b32 failed;
+    b32 is_partial;
+    b32 needs_more;
+} XmlScanner;
+
+#define xml_scanner_init(s) ((XmlScanner){.data = (s)})
+
+internal void xml_scanner_refill(XmlScanner *scanner, String data, b32 is_partial);
+
+internal usize xml_find_byte(String s, usize from, u8 byte);
+internal b32 xml_next(XmlScanner *scanner, XmlToken *out);
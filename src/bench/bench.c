@@ -0,0 +1,38 @@
+readonly global char BENCH_PADDING[BENCH_NAME_WIDTH + 1] = "                                        ";
+
+void bench_print(Arena *arena, const char *fmt, ...)
+{
+    va_list va;
+    va_start(va, fmt);
+    String line = string_fmt_va(arena, fmt, va);
+    va_end(va);
+
+    platform_file_write_string(platform_get_std_file(STDOUT), line);
+}
+
+// NOTE(cya): one short warm-up pass first, so page faults and cold caches
+// don't land in the timed runs; returns the best run in nanoseconds
+u64 bench_run(Arena *arena, BenchCase bench)
+{
+    bench_sink += bench.proc(bench.data, max(bench.iterations / 16, 1));
+
+    u64 best = ~(u64)0;
+    for (u32 run = 0; run < BENCH_RUNS; run++) {
+        u64 start = platform_get_time_ns();
+        bench_sink += bench.proc(bench.data, bench.iterations);
+        best = min(best, max(platform_get_time_ns() - start, 1));
+    }
+
+    String name = string_from_cstring(bench.name);
+    String pad = string_create(BENCH_PADDING, BENCH_NAME_WIDTH - min(name.len, BENCH_NAME_WIDTH));
+    u64 per_op = best / bench.iterations;
+    if (bench.bytes == 0) {
+        bench_print(arena, "{}{} {ns}/op\n", name, pad, per_op);
+    } else {
+        double total = (double)bench.bytes * (double)bench.iterations;
+        u64 rate = (u64)(total * 1e9 / (double)best);
+        bench_print(arena, "{}{} {ns}/op {size}/s\n", name, pad, per_op, rate);
+    }
+
+    return best;
+}
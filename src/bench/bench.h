@@ -0,0 +1,21 @@
+// NOTE(cya): shared by the programs in this directory, each a unity build
+// like mvn.c that times a few cases and prints one line per case
+#define BENCH_RUNS 7 // NOTE(cya): only the fastest one is reported
+#define BENCH_NAME_WIDTH 40
+
+// NOTE(cya): does `iterations` rounds of the work and returns something that
+// depends on all of them, so the compiler can't drop any
+typedef u64 BenchProc(void *data, u64 iterations);
+
+typedef struct {
+    const char *name;
+    BenchProc *proc;
+    void *data;
+    u64 iterations;
+    u64 bytes; // NOTE(cya): processed per iteration, 0 when it doesn't apply
+} BenchCase;
+
+global volatile u64 bench_sink;
+
+internal void bench_print(Arena *arena, const char *fmt, ...);
+internal u64 bench_run(Arena *arena, BenchCase bench);
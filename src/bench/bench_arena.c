@@ -0,0 +1,161 @@
+#include "../base/base.h"
+#include "../platform/platform.h"
+#include "bench.h"
+
+#include "../base/base.c"
+#include "../platform/platform.c"
+#include "bench.c"
+
+#include <stdlib.h> // malloc
+
+readonly force_keep char PROGRAM_NAME[] = "bench_arena";
+
+// NOTE(cya): the platform layer has no lock, nothing in the wrapper shares an
+// arena between threads
+#if defined(PLATFORM_WINDOWS)
+typedef SRWLOCK BenchLock;
+#    define bench_lock_init(l) InitializeSRWLock(l)
+#    define bench_lock(l) AcquireSRWLockExclusive(l)
+#    define bench_unlock(l) ReleaseSRWLockExclusive(l)
+#else
+typedef pthread_mutex_t BenchLock;
+#    define bench_lock_init(l) pthread_mutex_init((l), NULL)
+#    define bench_lock(l) pthread_mutex_lock(l)
+#    define bench_unlock(l) pthread_mutex_unlock(l)
+#endif
+
+#define ALLOC_BATCH 1024 // NOTE(cya): allocations between two releases
+#define ALLOC_MAX_THREADS 64
+#define ALLOC_POOL_CHUNK_SIZE kibibytes(256)
+
+typedef enum {
+    ALLOC_POOL, // NOTE(cya): a pool child per thread
+    ALLOC_MALLOC,
+    ALLOC_LOCKED_ARENA, // NOTE(cya): one arena shared behind a lock
+} AllocKind;
+
+typedef struct {
+    AllocKind kind;
+    u32 thread_count;
+    ArenaPool pool;
+    Arena shared;
+    BenchLock lock;
+} AllocCase;
+
+typedef struct {
+    AllocCase *alloc_case;
+    u64 count;
+    u64 sum;
+} AllocWorker;
+
+// NOTE(cya): about what the wrapper allocates: nodes, small strings, slots
+readonly global usize ALLOC_SIZES[] = {16, 24, 32, 48, 64, 96, 128, 256};
+
+// NOTE(cya): allocates in batches and releases each one before the next,
+// the way workers reuse their arena per task; the shared arena can't be
+// popped by one thread under the others, it's reset once they're done
+internal void bench_alloc_worker(void *data)
+{
+    AllocWorker *worker = data;
+    AllocCase *alloc_case = worker->alloc_case;
+    Arena child = arena_pool_child(&alloc_case->pool);
+    void *batch[ALLOC_BATCH];
+    u64 sum = 0;
+    for (u64 done = 0; done < worker->count; done += ALLOC_BATCH) {
+        usize count = (usize)min(ALLOC_BATCH, worker->count - done);
+        for (usize i = 0; i < count; i++) {
+            usize size = ALLOC_SIZES[i % array_len(ALLOC_SIZES)];
+            u8 *memory = NULL;
+            switch (alloc_case->kind) {
+            case ALLOC_POOL: {
+                memory = arena_push(&child, size);
+            } break;
+            case ALLOC_MALLOC: {
+                memory = malloc(size);
+                batch[i] = memory;
+            } break;
+            case ALLOC_LOCKED_ARENA: {
+                bench_lock(&alloc_case->lock);
+                memory = arena_push(&alloc_case->shared, size);
+                bench_unlock(&alloc_case->lock);
+            } break;
+            }
+
+            memory[0] = (u8)i;
+            sum += (uptr)memory & 0xFF;
+        }
+
+        if (alloc_case->kind == ALLOC_POOL) {
+            arena_pop_to(&child, 0);
+        } else if (alloc_case->kind == ALLOC_MALLOC) {
+            for (usize i = 0; i < count; i++) {
+                free(batch[i]);
+            }
+        }
+    }
+
+    worker->sum = sum;
+}
+
+// NOTE(cya): `iterations` is the total across threads, so the time per op
+// is the inverse of the combined throughput
+internal u64 bench_alloc(void *data, u64 iterations)
+{
+    AllocCase *alloc_case = data;
+    AllocWorker workers[ALLOC_MAX_THREADS];
+    Thread threads[ALLOC_MAX_THREADS];
+    ArenaTemp scratch = arena_scratch_begin(NULL, 0);
+    for (u32 i = 0; i < alloc_case->thread_count; i++) {
+        workers[i] = (AllocWorker){.alloc_case = alloc_case, .count = iterations / alloc_case->thread_count};
+        threads[i] = platform_thread_start(scratch.arena, bench_alloc_worker, &workers[i]);
+    }
+
+    u64 sum = 0;
+    for (u32 i = 0; i < alloc_case->thread_count; i++) {
+        platform_thread_join(threads[i]);
+        sum += workers[i].sum;
+    }
+
+    arena_reset(&alloc_case->shared);
+    arena_scratch_end(scratch);
+    return sum;
+}
+
+i32 entry_point(Arena *arena, CommandLine *cmd_line)
+{
+    unused(cmd_line);
+
+    AllocCase alloc_case = {
+        .pool = arena_pool_init(gibibytes(1), ALLOC_POOL_CHUNK_SIZE, ARENA_NO_RESERVE),
+        .shared = arena_init(64, mebibytes(1), ARENA_NO_RESERVE),
+    };
+    bench_lock_init(&alloc_case.lock);
+
+    // NOTE(cya): 4 threads even on fewer cores, contention on the lock shows
+    // up either way
+    u32 thread_counts[] = {1, 4, min(platform_get_processor_count(), ALLOC_MAX_THREADS)};
+    const char *names[] = {"pool child", "malloc/free", "locked arena_push"};
+    for (usize t = 0; t < array_len(thread_counts); t++) {
+        if (t > 0 && thread_counts[t] <= thread_counts[t - 1]) {
+            break;
+        }
+
+        alloc_case.thread_count = thread_counts[t];
+        for (AllocKind kind = ALLOC_POOL; kind <= ALLOC_LOCKED_ARENA; kind++) {
+            alloc_case.kind = kind;
+            const char *fmt = "{}, threads={u}";
+            String name = string_fmt(arena, fmt, string_from_cstring(names[kind]), (u64)thread_counts[t]);
+            BenchCase bench = {
+                .name = string_to_cstring(arena, name),
+                .proc = bench_alloc,
+                .data = &alloc_case,
+                .iterations = (u64)thread_counts[t] << 18,
+            };
+            bench_run(arena, bench);
+        }
+    }
+
+    arena_release(&alloc_case.shared);
+    arena_pool_release(&alloc_case.pool);
+    return 0;
+}
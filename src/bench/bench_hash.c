@@ -0,0 +1,107 @@
+#include "../base/base.h"
+#include "../platform/platform.h"
+#include "bench.h"
+
+#include "../base/base.c"
+#include "../platform/platform.c"
+#include "bench.c"
+
+readonly force_keep char PROGRAM_NAME[] = "bench_hash";
+
+#define BENCH_BYTES_PER_RUN mebibytes(64)
+#define STREAM_CHUNK_SIZE kibibytes(4)
+
+typedef struct {
+    u8 *buffer; // NOTE(cya): `len` plus 8 bytes of slack
+    usize len;
+} HashCase;
+
+// NOTE(cya): the start moves a little every round so the (pure) call can't
+// be hoisted out of the loop
+internal u64 bench_hash_64(void *data, u64 iterations)
+{
+    HashCase *hash_case = data;
+    u64 sum = 0;
+    for (u64 i = 0; i < iterations; i++) {
+        sum += hash_64(string_create(&hash_case->buffer[i & 7], hash_case->len), 0);
+    }
+
+    return sum;
+}
+
+internal u64 bench_hash_128(void *data, u64 iterations)
+{
+    HashCase *hash_case = data;
+    u64 sum = 0;
+    for (u64 i = 0; i < iterations; i++) {
+        Hash128 hash = hash_128(string_create(&hash_case->buffer[i & 7], hash_case->len), 0);
+        sum += hash.lo ^ hash.hi;
+    }
+
+    return sum;
+}
+
+// NOTE(cya): the way cache keys get built, piece by piece
+internal u64 bench_hash_stream(void *data, u64 iterations)
+{
+    HashCase *hash_case = data;
+    HashState state;
+    u64 sum = 0;
+    for (u64 i = 0; i < iterations; i++) {
+        hash_state_init(&state, 0);
+        for (usize pos = 0; pos < hash_case->len; pos += STREAM_CHUNK_SIZE) {
+            usize len = min(STREAM_CHUNK_SIZE, hash_case->len - pos);
+            hash_update(&state, string_create(&hash_case->buffer[pos + (i & 7)], len));
+        }
+
+        sum += hash_digest_64(&state);
+    }
+
+    return sum;
+}
+
+internal void bench_hash_case(Arena *arena, BenchProc *proc, const char *name, HashCase *hash_case)
+{
+    String label = string_fmt(arena, "{} {size}", string_from_cstring(name), (u64)hash_case->len);
+    BenchCase bench = {
+        .name = string_to_cstring(arena, label),
+        .proc = proc,
+        .data = hash_case,
+        .iterations = max(BENCH_BYTES_PER_RUN / hash_case->len, 1),
+        .bytes = hash_case->len,
+    };
+    bench_run(arena, bench);
+}
+
+i32 entry_point(Arena *arena, CommandLine *cmd_line)
+{
+    unused(cmd_line);
+
+    usize sizes[] = {16, 64, 240, kibibytes(1), kibibytes(64), mebibytes(1)};
+    usize largest = sizes[array_len(sizes) - 1];
+    u8 *buffer = arena_push(arena, largest + 8);
+    u64 state = 0x9E3779B97F4A7C15ull;
+    for (usize i = 0; i < largest + 8; i++) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        buffer[i] = (u8)(state >> 56);
+    }
+
+    for (usize i = 0; i < array_len(sizes); i++) {
+        HashCase hash_case = {.buffer = buffer, .len = sizes[i]};
+        bench_hash_case(arena, bench_hash_64, "hash_64", &hash_case);
+    }
+
+    HashCase long_case = {.buffer = buffer, .len = largest};
+    bench_hash_case(arena, bench_hash_128, "hash_128", &long_case);
+    bench_hash_case(arena, bench_hash_stream, "hash_update (4KiB chunks)", &long_case);
+
+#if defined(ARCH_X64)
+    // NOTE(cya): the long path again on the SSE2 kernels
+    if (cpu_features.has_avx2) {
+        cpu_features.has_avx2 = false;
+        bench_hash_case(arena, bench_hash_64, "hash_64 (sse2)", &long_case);
+        bench_hash_case(arena, bench_hash_stream, "hash_update (sse2, 4KiB chunks)", &long_case);
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,147 @@
+#include "../base/base.h"
+#include "../platform/platform.h"
+#include "bench.h"
+
+#include "../base/base.c"
+#include "../platform/platform.c"
+#include "bench.c"
+
+readonly force_keep char PROGRAM_NAME[] = "bench_map";
+
+typedef struct {
+    String *keys; // NOTE(cya): all in the map and the list
+    String *misses; // NOTE(cya): in neither, same shape as the keys
+    usize count;
+    HashMap map;
+    StringList list;
+    Arena build_arena; // NOTE(cya): reset before every build
+} MapCase;
+
+// NOTE(cya): the scan the map replaces, e.g. looking up env overrides or pom
+// properties in the order they were read
+internal StringNode *bench_list_find(StringList *list, String key)
+{
+    string_list_foreach(list, node) {
+        if (string_equals(node->str, key)) {
+            return node;
+        }
+    }
+
+    return NULL;
+}
+
+internal u64 bench_map_build(void *data, u64 iterations)
+{
+    MapCase *map_case = data;
+    u64 sum = 0;
+    for (u64 i = 0; i < iterations; i++) {
+        arena_reset(&map_case->build_arena);
+        HashMap map = hash_map_init(&map_case->build_arena, 0);
+        for (usize k = 0; k < map_case->count; k++) {
+            hash_map_insert(&map, map_case->keys[k], k);
+        }
+
+        sum += map.capacity;
+    }
+
+    return sum;
+}
+
+internal u64 bench_map_hit(void *data, u64 iterations)
+{
+    MapCase *map_case = data;
+    u64 sum = 0;
+    for (u64 i = 0; i < iterations; i++) {
+        u64 value = 0;
+        hash_map_get(&map_case->map, map_case->keys[i % map_case->count], &value);
+        sum += value;
+    }
+
+    return sum;
+}
+
+internal u64 bench_map_miss(void *data, u64 iterations)
+{
+    MapCase *map_case = data;
+    u64 sum = 0;
+    for (u64 i = 0; i < iterations; i++) {
+        sum += hash_map_find(&map_case->map, map_case->misses[i % map_case->count]) == NULL;
+    }
+
+    return sum;
+}
+
+internal u64 bench_list_hit(void *data, u64 iterations)
+{
+    MapCase *map_case = data;
+    u64 sum = 0;
+    for (u64 i = 0; i < iterations; i++) {
+        sum += bench_list_find(&map_case->list, map_case->keys[i % map_case->count])->str.len;
+    }
+
+    return sum;
+}
+
+internal u64 bench_list_miss(void *data, u64 iterations)
+{
+    MapCase *map_case = data;
+    u64 sum = 0;
+    for (u64 i = 0; i < iterations; i++) {
+        sum += bench_list_find(&map_case->list, map_case->misses[i % map_case->count]) == NULL;
+    }
+
+    return sum;
+}
+
+// NOTE(cya): shaped like property names, sharing long prefixes the way real
+// ones do ("maven.compiler.release", "project.build.sourceEncoding", ...)
+internal String *bench_keys_create(Arena *arena, const char *prefix, usize count)
+{
+    String *keys = arena_push_array(arena, count, String);
+    for (usize i = 0; i < count; i++) {
+        keys[i] = string_fmt(arena, "{}.plugin.configuration.{u}", string_from_cstring(prefix), (u64)i);
+    }
+
+    return keys;
+}
+
+i32 entry_point(Arena *arena, CommandLine *cmd_line)
+{
+    unused(cmd_line);
+
+    Arena build_arena = arena_init(16, mebibytes(1), 0);
+    usize counts[] = {8, 64, 1024};
+    for (usize c = 0; c < array_len(counts); c++) {
+        usize count = counts[c];
+        MapCase map_case = {
+            .keys = bench_keys_create(arena, "project", count),
+            .misses = bench_keys_create(arena, "profile", count),
+            .count = count,
+            .map = hash_map_init(arena, count),
+            .build_arena = build_arena,
+        };
+        for (usize k = 0; k < count; k++) {
+            hash_map_insert(&map_case.map, map_case.keys[k], k);
+            string_list_push_back(arena, &map_case.list, map_case.keys[k]);
+        }
+
+        // NOTE(cya): about the same time per case whatever the key count
+        u64 lookups = 1 << 20;
+        u64 scans = max((1 << 22) / count, 1);
+        BenchCase cases[] = {
+            {.name = "hash_map_insert (all keys)", .proc = bench_map_build, .iterations = lookups / count},
+            {.name = "hash_map_get hit", .proc = bench_map_hit, .iterations = lookups},
+            {.name = "hash_map_find miss", .proc = bench_map_miss, .iterations = lookups},
+            {.name = "StringList scan hit", .proc = bench_list_hit, .iterations = scans},
+            {.name = "StringList scan miss", .proc = bench_list_miss, .iterations = scans},
+        };
+        bench_print(arena, "{u} keys\n", (u64)count);
+        for (usize i = 0; i < array_len(cases); i++) {
+            cases[i].data = &map_case;
+            bench_run(arena, cases[i]);
+        }
+    }
+
+    arena_release(&build_arena);
+    return 0;
+}
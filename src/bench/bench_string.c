@@ -0,0 +1,138 @@
+#include "../base/base.h"
+#include "../platform/platform.h"
+#include "bench.h"
+
+#include "../base/base.c"
+#include "../platform/platform.c"
+#include "bench.c"
+
+readonly force_keep char PROGRAM_NAME[] = "bench_string";
+
+#define HAYSTACK_SIZE kibibytes(64)
+
+typedef struct {
+    String haystack;
+    String needle;
+} SearchCase;
+
+// NOTE(cya): `from` moves a little every round so the (pure) call can't be
+// hoisted out of the loop; the needle sits past all of those starts anyway
+internal u64 bench_string_find(void *data, u64 iterations)
+{
+    SearchCase *search = data;
+    u64 sum = 0;
+    for (u64 i = 0; i < iterations; i++) {
+        sum += string_find(search->haystack, search->needle, i & 7);
+    }
+
+    return sum;
+}
+
+// NOTE(cya): the byte at a time loop string_find replaced, and still runs
+// for its tails
+internal u64 bench_string_find_scalar(void *data, u64 iterations)
+{
+    SearchCase *search = data;
+    u64 sum = 0;
+    for (u64 i = 0; i < iterations; i++) {
+        sum += string_find_scalar(search->haystack, search->needle, i & 7);
+    }
+
+    return sum;
+}
+
+#if defined(PLATFORM_LINUX)
+internal u64 bench_memmem(void *data, u64 iterations)
+{
+    SearchCase *search = data;
+    u64 sum = 0;
+    for (u64 i = 0; i < iterations; i++) {
+        u8 *start = &search->haystack.str[i & 7];
+        usize len = search->haystack.len - (i & 7);
+        u8 *found = memmem(start, len, search->needle.str, search->needle.len);
+        sum += found == NULL ? search->haystack.len : (u64)(found - search->haystack.str);
+    }
+
+    return sum;
+}
+#endif
+
+// NOTE(cya): lowercase words and spaces, close enough to the text the wrapper
+// actually searches (poms, properties, release files)
+internal String bench_text_create(Arena *arena, usize size)
+{
+    u8 *text = arena_push(arena, size);
+    u64 state = 0x9E3779B97F4A7C15ull;
+    for (usize i = 0; i < size; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        text[i] = state % 6 == 0 ? ' ' : (u8)('a' + (state >> 8) % 26);
+    }
+
+    return string_create(text, size);
+}
+
+internal void bench_search_case(Arena *arena, BenchProc *proc, const char *kind, const char *name, SearchCase *search)
+{
+    String label = string_fmt(arena, "{} {}", string_from_cstring(kind), string_from_cstring(name));
+    BenchCase bench = {
+        .name = string_to_cstring(arena, label),
+        .proc = proc,
+        .data = search,
+        .iterations = proc == bench_string_find_scalar ? 200 : 2000,
+        .bytes = search->haystack.len,
+    };
+    bench_run(arena, bench);
+}
+
+internal void bench_search(Arena *arena, const char *name, String haystack, String needle)
+{
+    SearchCase search = {.haystack = haystack, .needle = needle};
+    assert_msg(string_find(haystack, needle, 0) == haystack.len - needle.len, "needle should only be at the end");
+
+    bench_search_case(arena, bench_string_find, "string_find", name, &search);
+#if defined(ARCH_X64)
+    // NOTE(cya): SSE2 is the baseline, AVX2 only a runtime pick
+    if (cpu_features.has_avx2) {
+        cpu_features.has_avx2 = false;
+        bench_search_case(arena, bench_string_find, "string_find (sse2)", name, &search);
+        cpu_features.has_avx2 = true;
+    }
+#endif
+    bench_search_case(arena, bench_string_find_scalar, "scalar loop", name, &search);
+#if defined(PLATFORM_LINUX)
+    bench_search_case(arena, bench_memmem, "memmem", name, &search);
+#endif
+}
+
+i32 entry_point(Arena *arena, CommandLine *cmd_line)
+{
+    unused(cmd_line);
+
+    // NOTE(cya): every needle is planted once, at the very end
+    String text = bench_text_create(arena, HAYSTACK_SIZE);
+    String needles[] = {
+        string_lit("</"),
+        string_lit("<version>"),
+        string_lit("<artifactId>maven-compiler-plugin</artifactId>"),
+    };
+    const char *names[] = {"2B", "9B", "47B"};
+    for (usize i = 0; i < array_len(needles); i++) {
+        String haystack = string_copy(arena, text);
+        mem_copy(&haystack.str[haystack.len - needles[i].len], needles[i].str, needles[i].len);
+        bench_search(arena, names[i], haystack, needles[i]);
+    }
+
+    // NOTE(cya): first and last byte match everywhere, so every candidate
+    // the vector filter lets through has to be verified
+    u8 *repeated = arena_push(arena, HAYSTACK_SIZE);
+    for (usize i = 0; i < HAYSTACK_SIZE; i++) {
+        repeated[i] = 'a';
+    }
+
+    String adversarial = string_lit("abaaaaaaaaaaaaaa");
+    mem_copy(&repeated[HAYSTACK_SIZE - adversarial.len], adversarial.str, adversarial.len);
+    bench_search(arena, "adversarial 16B", string_create(repeated, HAYSTACK_SIZE), adversarial);
+    return 0;
+}
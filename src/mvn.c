@@ -1,15 +1,70 @@
 #include "base/base.h"
 #include "platform/platform.h"
+#include "wrapper/wrapper.h"
 
 #include "base/base.c"
 #include "platform/platform.c"
+#include "wrapper/wrapper.c"
 
 readonly force_keep char PROGRAM_NAME[] = "mvn wrapper v0.4";
 readonly global char USER_PREFIX[] = "SENIOR";
 readonly global char JDK17_FLAGS[] = "--add-opens java.base/java.lang=ALL-UNNAMED";
-readonly global char *JDK_DIRS[] = {".jdks"};
+readonly global char *JDK_DIRS[] = {".jdks", ".sdkman/candidates/java", ".asdf/installs/java"};
+readonly global char *JDK_SYSTEM_DIRS[] = PLATFORM_JDK_SYSTEM_DIRS;
+readonly global char JDK_HOME_ENV[] = "JAVA_HOME";
 readonly global char *POM_DIRS[] = {"", "java"};
-readonly global char *JDK_VENDOR_PATTERNS[] = {"jdk", "temurin", "coretto"};
+readonly global char *JDK_VENDOR_PATTERNS[] = {
+    "jdk", "java", "openjdk", "temurin", "corretto", "zulu", "graalvm", "semeru",
+    "liberica", "sapmachine",
+};
+readonly global char WRAPPER_OPTION_PREFIX[] = "--wrapper-";
+
+typedef enum {
+    LAUNCH_MODE_EXEC, // NOTE(cya): replace the wrapper process with maven
+    LAUNCH_MODE_SPAWN, // NOTE(cya): run maven as a child and wait on it
+} LaunchMode;
+
+typedef struct {
+    LaunchMode launch_mode;
+    b32 force_script; // NOTE(cya): skip the native bootstrap
+    b32 no_cache; // NOTE(cya): always run discovery (and don't store it)
+    String arena_stats_path; // NOTE(cya): where to dump main arena stats, if set
+    String log_path; // NOTE(cya): log there instead of stdout, if set
+    String trace_path; // NOTE(cya): where to write the phase trace, if set
+} WrapperOptions;
+
+// NOTE(cya): a stretch of the run that shows up both in the arena stats (as a
+// tag) and in the trace (as a span)
+typedef struct {
+    const char *prev_tag;
+    TraceScope scope;
+} Phase;
+
+// NOTE(cya): the inputs discovery works from
+typedef struct {
+    String curr_user;
+    String home;
+    String maven_home;
+    String path;
+    StringArray path_dirs;
+    PathProbe path_probe;
+    StringList *arguments;
+    b32 use_cache;
+} Environment;
+
+internal inline Phase phase_begin(Arena *arena, const char *name)
+{
+    return (Phase){
+        .prev_tag = arena_tag_set(arena, name),
+        .scope = trace_begin(name, TRACE_TRACK_WRAPPER),
+    };
+}
+
+internal inline void phase_end(Arena *arena, Phase phase)
+{
+    trace_end(phase.scope);
+    arena_tag_set(arena, phase.prev_tag);
+}
 
 internal inline String string_path_pop_bin(String path)
 {
@@ -18,126 +73,562 @@ internal inline String string_path_pop_bin(String path)
         string_path_pop_element(path) : path;
 }
 
-void entry_point(Arena *arena, CommandLine *cmd_line)
+// NOTE(cya): consumes our own `--wrapper-*` flags so maven never sees them
+internal WrapperOptions wrapper_options_parse(StringList *arguments)
 {
-    log_debug("running {}", string_lit(PROGRAM_NAME));
+    WrapperOptions options = {.launch_mode = LAUNCH_MODE_EXEC};
+    String prefix = string_lit(WRAPPER_OPTION_PREFIX);
+    StringList rest = {0};
+    while (arguments->node_count > 0) {
+        StringNode *node = arguments->first;
+        string_list_pop_front(arguments);
 
-    String curr_user = platform_get_current_username(arena);
-    String home = platform_get_home_directory(arena);
-    log_debug("[user={},home={}]", curr_user, home);
+        String argument = node->str;
+        if (!string_starts_with(argument, prefix)) {
+            string_list_push_node_back(&rest, node);
+            continue;
+        }
 
-    String maven_home = platform_get_env(arena, string_lit("MAVEN_HOME"));
-    String path = platform_get_env(arena, string_lit("PATH"));
-    String delimiter = string_lit(PLATFORM_ENV_SEPARATOR);
-    StringList path_list = string_split(arena, path, delimiter);
-    String mvn_path = string_lit("");
+        String option = string_cut_leading(argument, prefix.len);
+        String arena_stats = string_lit("arena-stats=");
+        String log_level = string_lit("log-level=");
+        String log_file = string_lit("log-file=");
+        String trace_file = string_lit("trace=");
+        if (string_equals(option, string_lit("spawn"))) {
+            options.launch_mode = LAUNCH_MODE_SPAWN;
+        } else if (string_equals(option, string_lit("script"))) {
+            options.force_script = true;
+        } else if (string_equals(option, string_lit("no-cache"))) {
+            options.no_cache = true;
+        } else if (string_starts_with(option, arena_stats)) {
+            options.arena_stats_path = string_cut_leading(option, arena_stats.len);
+        } else if (string_starts_with(option, trace_file)) {
+            options.trace_path = string_cut_leading(option, trace_file.len);
+        } else if (string_starts_with(option, log_file)) {
+            options.log_path = string_cut_leading(option, log_file.len);
+        } else if (string_starts_with(option, log_level)) {
+            // NOTE(cya): applied right away, so it covers the rest of parsing
+            String name = string_cut_leading(option, log_level.len);
+            if (!log_level_parse(name, &log.level)) {
+                log_warn("ignoring unknown log level {}", name);
+            }
+        } else {
+            log_warn("ignoring unknown wrapper option {}", argument);
+        }
+    }
+
+    *arguments = rest;
+    return options;
+}
+
+internal String resolve_mvn_path(Arena *arena, String maven_home, PathProbe *path_probe)
+{
     if (!string_is_empty(maven_home)) {
         log_info("using maven from MAVEN_HOME @ {}", maven_home);
-        mvn_path = string_path_append(arena, maven_home, string_lit("bin"));
-    } else {
-        // NOTE(cya): exclude ourselves from the paths to search for
-        String process_exe = platform_get_process_filename(arena);
-        String process_dir = string_path_pop_element(process_exe);
-        string_list_pop_matches(&path_list, process_dir);
-
-        mvn_path = platform_find_first_file(arena, &path_list, PLATFORM_MVN_FILE);
-        if (string_is_empty(mvn_path)) {
-            log_error("no maven directory found (check your PATH or MAVEN_HOME)");
-            return;
-        }
+        return string_path_append(arena, maven_home, string_lit("bin"));
+    }
+
+    // NOTE(cya): exclude ourselves from the paths to search for (however
+    // PATH spells our directory)
+    String process_exe = platform_get_process_filename(arena);
+    String process_dir = string_path_pop_element(process_exe);
+    platform_path_probe_exclude(path_probe, process_dir);
 
+    String mvn_path = platform_path_probe_find(path_probe, PLATFORM_MVN_FILE);
+    if (!string_is_empty(mvn_path)) {
         log_info("using maven from PATH @ {}", string_path_pop_bin(mvn_path));
     }
 
-    String mvn_launcher = string_path_append(arena, mvn_path, PLATFORM_MVN_FILE);
-    if (!platform_file_exists(arena, mvn_launcher)) {
-        log_error("maven launcher not found @ {}", string_path_pop_bin(mvn_path));
-        return;
+    return mvn_path;
+}
+
+// NOTE(cya): the cwd's own poms first; run from inside a project (its src/,
+// say) it's the closest parent directory that has one
+internal Pom *resolve_project_pom(Arena *arena, PomCache *cache, String *out_path)
+{
+    // NOTE(cya): stat'ed together up front, only the ones that exist get opened
+    FileStatEntry candidates[array_len(POM_DIRS)];
+    for (usize i = 0; i < array_len(POM_DIRS); i++) {
+        String dir = string_from_cstring(POM_DIRS[i]);
+        candidates[i] = (FileStatEntry){
+            .path = string_path_append(arena, dir, string_lit("pom.xml")),
+        };
+    }
+
+    platform_file_stat_batch(arena, candidates, array_len(candidates));
+    for (usize i = 0; i < array_len(candidates); i++) {
+        if (!candidates[i].exists || candidates[i].stat.is_dir) {
+            continue;
+        }
+
+        String path = candidates[i].path;
+        Pom *pom = pom_cache_get(cache, path);
+
+        if (pom != NULL) {
+            *out_path = path;
+            return pom;
+        }
+    }
+
+    String pom_file = string_lit("pom.xml");
+    String start = string_path_pop_element(platform_get_current_directory(arena));
+    String root = platform_path_find_upwards(start, pom_file, PATH_KIND_FILE);
+    if (string_is_empty(root)) {
+        return NULL;
+    }
+
+    // NOTE(cya): one showing up closer to the cwd would take over
+    for (String dir = start; dir.len > root.len; dir = string_path_pop_element(dir)) {
+        pom_cache_miss(cache, string_path_append(arena, dir, pom_file));
+    }
+
+    String path = string_path_append(arena, root, pom_file);
+    Pom *pom = pom_cache_get(cache, path);
+    if (pom != NULL) {
+        *out_path = path;
+    }
+
+    return pom;
+}
+
+internal String resolve_target_version(
+    Arena *arena,
+    String home,
+    StringList *arguments,
+    b32 use_cache,
+    String *out_pom_file,
+    StringList *out_inputs,
+    StringList *out_env_inputs
+) {
+    // NOTE(cya): command line definitions win over anything in the poms
+    PropertyTable properties = property_table_init(arena, 64);
+    properties.env_reads = out_env_inputs;
+    property_table_push_cli(&properties, arguments);
+
+    String repository = property_table_get(&properties, string_lit("maven.repo.local"));
+    if (string_is_empty(repository)) {
+        String m2 = string_path_append(arena, home, string_lit(".m2"));
+        repository = string_path_append(arena, m2, string_lit("repository"));
     }
 
+    PomCache cache = pom_cache_init(arena, repository);
     String version = string_lit("");
-    String pom_file = string_lit("");
-    for (usize i = 0; i < array_len(POM_DIRS) && string_is_empty(version); i++) {
-        String dir = string_from_cstring(POM_DIRS[i]);
-        String path = string_path_append(arena, dir, string_lit("pom.xml"));
-        File file = platform_file_open(arena, path);
-        if (platform_file_is_valid(file)) {
-            String pom = platform_file_read_into_string(arena, file);
-            platform_file_close(file);
+    String path;
+    Pom *pom = resolve_project_pom(arena, &cache, &path);
+    if (pom == NULL) {
+        *out_inputs = cache.missing;
+        return version;
+    }
+
+    // NOTE(cya): an aggregator needs the highest level of all its modules
+    *out_pom_file = path;
+    if (pom->modules.node_count > 0) {
+        Phase phase = phase_begin(arena, "reactor");
+        Reactor reactor = reactor_scan(arena, &cache, pom, arguments, use_cache);
+        phase_end(arena, phase);
+        if (reactor.count > 0) {
+            log_debug(
+                "scanned {u} reactor modules ({u} parsed, {u} dependency edges)",
+                (u64)reactor.count,
+                (u64)reactor.parsed,
+                (u64)reactor.edge_count
+            );
+
+            if (!string_is_empty(reactor.java_version)) {
+                version = reactor.java_version;
+                *out_pom_file = reactor.java_version_pom;
+            }
 
-            String target_tag = string_lit("<maven.compiler.target>");
-            String pos = string_skip_first_match(pom, target_tag);
+            *out_inputs = reactor.inputs;
+            string_list_foreach(&reactor.env_inputs, node) {
+                string_list_push_back(arena, out_env_inputs, node->str);
+            }
 
-            version = string_keep_number(pos);
-            pom_file = path;
+            return version;
         }
     }
 
-    String jdk_path = string_lit("");
-    if (string_is_empty(version)) {
+    pom_cache_push_properties(&cache, pom, &properties);
+    Pom merged = pom_cache_merge_chain(&cache, pom);
+    version = pom_java_version(arena, &merged, &properties);
+
+    *out_inputs = cache.loaded;
+    string_list_foreach(&cache.missing, node) {
+        string_list_push_back(arena, out_inputs, node->str);
+    }
+
+    return version;
+}
+
+// NOTE(cya): install roots hold one JDK per child dir
+internal void jdk_roots(Arena *arena, String home, StringList *roots)
+{
+    for (usize i = 0; i < array_len(JDK_DIRS); i++) {
+        String dir = string_from_cstring(JDK_DIRS[i]);
+        string_list_push_back(arena, roots, string_path_append(arena, home, dir));
+    }
+
+    for (usize i = 0; i < array_len(JDK_SYSTEM_DIRS); i++) {
+        string_list_push_back(arena, roots, string_from_cstring(JDK_SYSTEM_DIRS[i]));
+    }
+}
+
+// NOTE(cya): homes are JDKs themselves (JAVA_HOME and CI-style
+// JAVA_HOME_17_X64 variables)
+internal void jdk_homes(Arena *arena, StringList *homes)
+{
+    String key = string_lit(JDK_HOME_ENV);
+    StringList env = platform_get_env_list(arena);
+    string_list_foreach(&env, node) {
+        String entry = node->str;
+        if (!string_starts_with(entry, key) || entry.len <= key.len) {
+            continue;
+        }
+
+        u8 next = entry.str[key.len];
+        if (next == '=' || next == '_') {
+            String value = string_skip_first_match(entry, string_lit("="));
+            if (!string_is_empty(value)) {
+                string_list_push_back(arena, homes, value);
+            }
+        }
+    }
+}
+
+internal String resolve_jdk_path(
+    Arena *arena,
+    String home,
+    StringArray *path_dirs,
+    String version,
+    b32 use_cache
+) {
+    StringList roots = {0}, homes = {0};
+    jdk_roots(arena, home, &roots);
+    jdk_homes(arena, &homes);
+
+    JdkInventory inventory = jdk_inventory_load(arena, &roots, &homes, use_cache);
+    JdkEntry *entry = jdk_inventory_find(&inventory, (u32)string_parse_u64(version));
+    if (entry != NULL) {
+        log_debug("matched {} JDK {}", entry->implementor, entry->version);
+        return entry->path;
+    }
+
+    // NOTE(cya): fall back to vendor-specific install-path patterns on PATH
+    // ("temurin-17", "java-17-openjdk", ...), all looked for in one pass
+    StringList patterns = {0};
+    for (usize i = 0; i < array_len(JDK_VENDOR_PATTERNS); i++) {
+        String vendor = string_from_cstring(JDK_VENDOR_PATTERNS[i]);
+        String pattern = string_join(arena, string_lit("-"), vendor, version);
+        string_list_push_back(arena, &patterns, pattern);
+    }
+
+    StringMatcher matcher = string_matcher_build(arena, &patterns);
+    String jdk_path = string_array_find_first_word_match(path_dirs, &matcher);
+    return string_is_empty(jdk_path) ? jdk_path : string_path_pop_bin(jdk_path);
+}
+
+internal b32 resolve(Arena *arena, Environment *env, Resolution *out)
+{
+    Phase phase = phase_begin(arena, "maven");
+    Resolution result = {0};
+    result.mvn_path = resolve_mvn_path(arena, env->maven_home, &env->path_probe);
+    phase_end(arena, phase);
+    if (string_is_empty(result.mvn_path)) {
+        log_error("no maven directory found (check your PATH or MAVEN_HOME)");
+        return false;
+    }
+
+    phase = phase_begin(arena, "pom");
+    result.version = resolve_target_version(
+        arena,
+        env->home,
+        env->arguments,
+        env->use_cache,
+        &result.pom_file,
+        &result.inputs,
+        &result.env_inputs
+    );
+
+    phase_end(arena, phase);
+    if (string_is_empty(result.version)) {
         log_warn("no JDK target property found (using JAVA_HOME)");
     } else {
-        log_info("found JDK {} target @ {}", version, pom_file);
-
-        // NOTE(cya): prepend dirs from known install locations
-        for (usize i = 0; i < array_len(JDK_DIRS); i++) {
-            String dir = string_from_cstring(JDK_DIRS[i]);
-            String full_dir = string_path_append(arena, home, dir);
-            if (platform_file_exists(arena, full_dir)) {
-                FileInfo info;
-                u32 flags = FILE_ITER_SKIP_FILES | FILE_ITER_SKIP_HIDDEN;
-                FileIter *iter = platform_file_iter_begin(arena, full_dir, flags);
-                while (platform_file_iter_next(arena, iter, &info)) {
-                    String path = string_path_append(arena, full_dir, info.name);
-                    string_list_push_front(arena, &path_list, path);
-                }
-
-                platform_file_iter_end(iter);
+        log_info("found JDK {} target @ {}", result.version, result.pom_file);
+
+        phase = phase_begin(arena, "jdk");
+        result.jdk_path = resolve_jdk_path(
+            arena,
+            env->home,
+            &env->path_dirs,
+            result.version,
+            env->use_cache
+        );
+        phase_end(arena, phase);
+        if (string_is_empty(result.jdk_path)) {
+            log_warn("found no JDK {} installation (using JAVA_HOME)", result.version);
+        } else {
+            log_info("found JDK {} installation @ {}", result.version, result.jdk_path);
+
+            u64 version_num = string_parse_u64(result.version);
+            String user_prefix = string_lit(USER_PREFIX);
+            if (version_num == 17 && string_starts_with(env->curr_user, user_prefix)) {
+                result.maven_opts = string_lit(JDK17_FLAGS);
             }
         }
+    }
+
+    *out = result;
+    return true;
+}
+
+// NOTE(cya): everything the resolution depends on that's already in memory; a
+// change to the environment picks a different entry without touching the disk
+internal CacheKey resolution_cache_key(Arena *arena, Environment *env)
+{
+    StringList env_values = {0};
+    string_list_push_back(arena, &env_values, env->curr_user);
+    string_list_push_back(arena, &env_values, env->home);
+    string_list_push_back(arena, &env_values, env->maven_home);
+    string_list_push_back(arena, &env_values, env->path);
+
+    // NOTE(cya): `-D` definitions can override the pom's properties
+    StringList definitions = property_cli_definitions(arena, env->arguments);
+    string_list_foreach(&definitions, node) {
+        string_list_push_back(arena, &env_values, node->str);
+    }
+
+    jdk_homes(arena, &env_values);
 
-        // NOTE(cya): build our vendor-specific install-path patterns
-        StringList patterns = {0};
-        for (usize i = 0; i < array_len(JDK_VENDOR_PATTERNS); i++) {
-            String vendor = string_from_cstring(JDK_VENDOR_PATTERNS[i]);
-            String pattern = string_join(arena, string_lit("-"), vendor, version);
-            string_list_push_back(arena, &patterns, pattern);
+    String project_dir = platform_get_current_directory(arena);
+    return cache_key_create(project_dir, &env_values);
+}
+
+// NOTE(cya): the paths whose stamps are stored next to what resolving read,
+// so that a pom or JDK install showing up (or going away) invalidates it
+internal void resolution_watch_paths(Arena *arena, Environment *env, StringList *inputs)
+{
+    for (usize i = 0; i < array_len(POM_DIRS); i++) {
+        String dir = string_from_cstring(POM_DIRS[i]);
+        String pom = string_path_append(arena, dir, string_lit("pom.xml"));
+        string_list_push_back(arena, inputs, pom);
+    }
+
+    jdk_roots(arena, env->home, inputs);
+}
+
+// NOTE(cya): the stamps only cover what resolving read, not the directories it
+// ended up picking
+internal b32 resolution_is_installed(Arena *arena, Resolution *resolution)
+{
+    String mvn_launcher = string_path_append(arena, resolution->mvn_path, PLATFORM_MVN_FILE);
+    if (!platform_file_exists(arena, mvn_launcher)) {
+        return false;
+    }
+
+    String jdk_path = resolution->jdk_path;
+    return string_is_empty(jdk_path) || platform_dir_exists(arena, jdk_path);
+}
+
+// NOTE(cya): both are built in scratch, and written exactly once per run (in
+// exec mode right before maven replaces us)
+internal void wrapper_reports_store(Arena *arena, WrapperOptions *options)
+{
+    String stats_path = options->arena_stats_path;
+    if (!string_is_empty(stats_path)) {
+        ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+        if (!arena_stats_store(arena, string_to_cstring(scratch.arena, stats_path))) {
+            log_warn("unable to write arena stats to {}", stats_path);
         }
 
-        jdk_path = string_list_find_first_match(&path_list, &patterns);
-        if (string_is_empty(jdk_path)) {
-            log_warn("found no JDK {} installation (using JAVA_HOME)", version);
-        } else {
-            jdk_path = string_path_pop_bin(jdk_path);
+        arena_scratch_end(scratch);
+    }
 
-            log_info("found JDK {} installation @ {}", version, jdk_path);
-            String jdk_key = string_lit("JAVA_HOME");
-            platform_set_env(arena, jdk_key, jdk_path);
+    String trace_path = options->trace_path;
+    if (!string_is_empty(trace_path) && !trace_store(arena, trace_path)) {
+        log_warn("unable to write trace to {}", trace_path);
+    }
+}
 
-            u64 version_num = string_parse_u64(version);
-            String user_prefix = string_lit(USER_PREFIX);
-            if (version_num == 17 && string_starts_with(curr_user, user_prefix)) {
-                platform_set_env(arena, string_lit("MAVEN_OPTS"), string_lit(JDK17_FLAGS));
-            }
+// NOTE(cya): everything up to having maven's command line ready
+internal b32 wrapper_run(
+    Arena *arena,
+    WrapperOptions *options,
+    CommandLine *cmd_line,
+    CommandLine *out_mvn_cmd_line
+)
+{
+    Phase phase = phase_begin(arena, "environment");
+    Environment env = {
+        .curr_user = platform_get_current_username(arena),
+        .home = platform_get_home_directory(arena),
+        .maven_home = platform_get_env(arena, string_lit("MAVEN_HOME")),
+        .path = platform_get_env(arena, string_lit("PATH")),
+        .arguments = cmd_line->arguments,
+        .use_cache = !options->no_cache,
+    };
+    log_debug("[user={},home={}]", env.curr_user, env.home);
+
+    StringSplitIter path_iter = string_split_iter(env.path, string_lit(PLATFORM_ENV_SEPARATOR));
+    String dir;
+    while (string_split_next(&path_iter, &dir)) {
+        string_array_push(arena, &env.path_dirs, dir);
+    }
+
+    phase_end(arena, phase);
+    phase = phase_begin(arena, "cache");
+    Resolution resolution;
+    CacheKey cache_key = resolution_cache_key(arena, &env);
+    b32 cached = !options->no_cache && cache_load(arena, &cache_key, &resolution);
+    if (cached && !resolution_is_installed(arena, &resolution)) {
+        // NOTE(cya): maven or the JDK was uninstalled since; the entry gets
+        // overwritten by the fresh resolution below
+        log_debug("dropping stale cached resolution for {}", cache_key.project_dir);
+        cached = false;
+    }
+
+    phase_end(arena, phase);
+    if (cached) {
+        log_debug("using cached resolution for {}", cache_key.project_dir);
+        log_info("using maven @ {}", string_path_pop_bin(resolution.mvn_path));
+        if (!string_is_empty(resolution.jdk_path)) {
+            log_info("found JDK {} installation @ {}", resolution.version, resolution.jdk_path);
+        }
+    } else {
+        phase = phase_begin(arena, "path probe");
+        env.path_probe = platform_path_probe_init(arena, &env.path_dirs);
+        phase_end(arena, phase);
+        if (!resolve(arena, &env, &resolution)) {
+            return false;
         }
+
+        resolution_watch_paths(arena, &env, &resolution.inputs);
+    }
+
+    String mvn_path = resolution.mvn_path;
+    String mvn_launcher = string_path_append(arena, mvn_path, PLATFORM_MVN_FILE);
+    if (!platform_file_exists(arena, mvn_launcher)) {
+        log_error("maven launcher not found @ {}", string_path_pop_bin(mvn_path));
+        return false;
+    }
+
+    phase = phase_begin(arena, "cache");
+    if (!cached && !options->no_cache && !cache_store(arena, &cache_key, &resolution)) {
+        log_debug("unable to write resolution cache for {}", cache_key.project_dir);
     }
 
-    log_info("launching mvn script @ {}", string_path_pop_bin(mvn_path));
+    phase_end(arena, phase);
+    if (!string_is_empty(resolution.jdk_path)) {
+        platform_set_env(arena, string_lit("JAVA_HOME"), resolution.jdk_path);
+    }
+
+    if (!string_is_empty(resolution.maven_opts)) {
+        platform_set_env(arena, string_lit("MAVEN_OPTS"), resolution.maven_opts);
+    }
+
+    phase = phase_begin(arena, "bootstrap");
+    // NOTE(cya): a cache hit gets here without one, it's only used to look
+    // java up when JAVA_HOME isn't set
+    if (cached) {
+        env.path_probe = platform_path_probe_init(arena, &env.path_dirs);
+    }
 
     StringList *arguments = cmd_line->arguments;
-    String mvn_full_path = string_path_append(arena, mvn_path, PLATFORM_MVN_FILE);
-    string_list_push_front(arena, arguments, mvn_full_path);
-    string_list_push_front(arena, arguments, string_lit(PLATFORM_SHELL_CMD_FLAG));
-    CommandLine mvn_cmd_line = {
-        .exe_name = string_lit(PLATFORM_SHELL_NAME),
-        .arguments = arguments,
-    };
+    MavenBootstrap bootstrap;
+    CommandLine mvn_cmd_line;
+    b32 native = !options->force_script &&
+        bootstrap_resolve(arena, mvn_launcher, &env.path_probe, arguments, &bootstrap);
+    platform_path_probe_release(&env.path_probe);
+    if (native) {
+        log_info("launching maven natively @ {}", bootstrap.maven_home);
+        mvn_cmd_line = bootstrap_command_line(arena, &bootstrap, arguments);
+    } else {
+        log_info("launching mvn script @ {}", string_path_pop_bin(mvn_path));
+        string_list_push_front(arena, arguments, mvn_launcher);
+
+        String shell_flag = string_lit(PLATFORM_SHELL_CMD_FLAG);
+        if (!string_is_empty(shell_flag)) {
+            string_list_push_front(arena, arguments, shell_flag);
+        }
+
+        mvn_cmd_line = (CommandLine){
+            .exe_name = string_lit(PLATFORM_SHELL_NAME),
+            .arguments = arguments,
+        };
+    }
+
+    phase_end(arena, phase);
+    *out_mvn_cmd_line = mvn_cmd_line;
+    return true;
+}
+
+internal i32 wrapper_launch(Arena *arena, WrapperOptions *options, CommandLine *mvn_cmd_line)
+{
+    // NOTE(cya): everything of ours goes out before maven starts writing, and
+    // nothing runs after a successful exec
+    Phase phase = phase_begin(arena, "launch");
+    if (options->launch_mode == LAUNCH_MODE_EXEC) {
+        phase_end(arena, phase);
+
+        // NOTE(cya): maven replaces us, so its span can be opened but not ended
+        trace_leave_open(trace_begin("maven", TRACE_TRACK_CHILD));
+        wrapper_reports_store(arena, options);
 
-    Process proc = platform_process_spawn(arena, &mvn_cmd_line);
-    b32 success = platform_process_await(proc);
+        log_flush();
+        platform_process_exec(arena, mvn_cmd_line);
+
+        String error = platform_get_error_message(platform_get_last_error());
+        log_error("unable to exec maven: {}", error);
+        return 1;
+    }
+
+    i32 exit_code = 1;
+    log_flush();
+    Process proc = platform_process_spawn(arena, mvn_cmd_line);
+    phase_end(arena, phase);
+
+    TraceScope child = trace_begin("maven", TRACE_TRACK_CHILD);
+    b32 success = platform_process_await(proc, &exit_code);
+    trace_end(child);
     if (!success) {
         String error = platform_get_error_message(platform_get_last_error());
-        log_error("unable to launch mvn script: {}", error);
-        return;
+        log_error("unable to launch maven: {}", error);
+        exit_code = 1;
     }
+
+    wrapper_reports_store(arena, options);
+    return exit_code;
+}
+
+i32 entry_point(Arena *arena, CommandLine *cmd_line)
+{
+    log_debug("running {}", string_lit(PROGRAM_NAME));
+
+    WrapperOptions options = wrapper_options_parse(cmd_line->arguments);
+    if (!string_is_empty(options.log_path) && !log_set_file(arena, options.log_path)) {
+        log_warn("unable to open log file {}", options.log_path);
+    }
+
+    ArenaStats stats;
+    if (!string_is_empty(options.arena_stats_path)) {
+        arena_stats_attach(arena, &stats);
+    }
+
+    if (!string_is_empty(options.trace_path)) {
+        trace_enable();
+    }
+
+    TraceScope run = trace_begin("wrapper", TRACE_TRACK_WRAPPER);
+    CommandLine mvn_cmd_line;
+    b32 is_ready = wrapper_run(arena, &options, cmd_line, &mvn_cmd_line);
+    trace_end(run);
+
+    i32 exit_code = 1;
+    if (is_ready) {
+        exit_code = wrapper_launch(arena, &options, &mvn_cmd_line);
+    } else {
+        wrapper_reports_store(arena, &options);
+    }
+
+    arena->stats = NULL;
+    return exit_code;
 }
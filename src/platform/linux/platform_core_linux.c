@@ -3,16 +3,37 @@ inline usize platform_get_page_size(void)
     return sysconf(_SC_PAGESIZE);
 }
 
-inline void *platform_mem_reserve(void *addr, usize size)
+inline void *platform_mem_reserve(void *addr, usize size, u32 flags)
 {
-    void *result = mmap(addr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-    return result == MAP_FAILED ? NULL : result;
+    int map_flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    if (flags & PLATFORM_MEM_NO_RESERVE) {
+        map_flags |= MAP_NORESERVE;
+    }
+
+    void *result = mmap(addr, size, PROT_NONE, map_flags, -1, 0);
+    if (result == MAP_FAILED) {
+        return NULL;
+    }
+
+#if defined(MADV_HUGEPAGE)
+    // NOTE(cya): only a hint, THP may be disabled or set to "never"
+    if (flags & PLATFORM_MEM_HUGE_PAGES) {
+        madvise(result, size, MADV_HUGEPAGE);
+    }
+#endif
+    return result;
 }
 
 inline void *platform_mem_commit(void *addr, usize size)
 {
-    mprotect(addr, size, PROT_READ | PROT_WRITE);
-    return addr;
+    return mprotect(addr, size, PROT_READ | PROT_WRITE) == 0 ? addr : NULL;
+}
+
+// NOTE(cya): the pages are dropped, the range stays reserved
+inline void platform_mem_decommit(void *addr, usize size)
+{
+    madvise(addr, size, MADV_DONTNEED);
+    mprotect(addr, size, PROT_NONE);
 }
 
 inline void platform_mem_release(void *addr, usize size)
@@ -22,25 +43,39 @@ inline void platform_mem_release(void *addr, usize size)
 
 String platform_get_process_filename(Arena *arena)
 {
-    usize buf_size = PATH_MAX;
-    char *buf = arena_push(arena, buf_size);
-    i32 len = readlink("/proc/self/exe", buf, buf_size - 1);
-    if (len == -1) {
-        return string_lit("");
-    }
-
-    buf[len] = '\0';
-    return string_create(buf, len);
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    char *buf = arena_push(scratch.arena, PATH_MAX);
+    i32 len = readlink("/proc/self/exe", buf, PATH_MAX);
+    String result = len == -1 ? string_lit("") : string_copy(arena, string_create(buf, len));
+    arena_scratch_end(scratch);
+    return result;
 }
 
+// NOTE(cya): the value points into the environment block, no copy is made
 String platform_get_env(Arena *arena, String key)
 {
-    return string_from_cstring(getenv(string_to_cstring(arena, key)));
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    char *value = getenv(string_to_cstring(scratch.arena, key));
+    arena_scratch_end(scratch);
+    return string_from_cstring(value);
 }
 
 inline void platform_set_env(Arena *arena, String key, String val)
 {
-    setenv(string_to_cstring(arena, key), string_to_cstring(arena, val), 1);
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    setenv(string_to_cstring(scratch.arena, key), string_to_cstring(scratch.arena, val), 1);
+    arena_scratch_end(scratch);
+}
+
+// NOTE(cya): `KEY=VALUE` entries
+StringList platform_get_env_list(Arena *arena)
+{
+    StringList result = {0};
+    for (char **env = environ; *env != NULL; env++) {
+        string_list_push_back(arena, &result, string_from_cstring(*env));
+    }
+
+    return result;
 }
 
 internal inline usize linux_file_size(i32 descriptor)
@@ -52,13 +87,24 @@ internal inline usize linux_file_size(i32 descriptor)
 
 File platform_file_open(Arena *arena, String path)
 {
-    int descriptor = open(string_to_cstring(arena, path), O_RDONLY);
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    int descriptor = open(string_to_cstring(scratch.arena, path), O_RDONLY);
+    arena_scratch_end(scratch);
     return (File){
         .descriptor = descriptor,
         .size = descriptor == -1 ? 0 : linux_file_size(descriptor),
     };
 }
 
+File platform_file_create(Arena *arena, String path)
+{
+    int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    int descriptor = open(string_to_cstring(scratch.arena, path), flags, 0644);
+    arena_scratch_end(scratch);
+    return (File){.descriptor = descriptor};
+}
+
 b32 platform_file_close(File file)
 {
     return close(file.descriptor) == 0;
@@ -66,87 +112,631 @@ b32 platform_file_close(File file)
 
 b32 platform_file_exists(Arena *arena, String path)
 {
-    return access(string_to_cstring(arena, path), F_OK) == 0;
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    b32 exists = access(string_to_cstring(scratch.arena, path), F_OK) == 0;
+    arena_scratch_end(scratch);
+    return exists;
 }
 
-inline String platform_file_read_into_string(Arena *arena, File file)
+b32 platform_dir_exists(Arena *arena, String path)
 {
-    usize size = file.size;
-    u8 *buf = arena_push(arena, size);
-    read(file.descriptor, buf, size);
-    return string_create(buf, size);
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    struct stat st;
+    b32 found = stat(string_to_cstring(scratch.arena, path), &st) == 0;
+    arena_scratch_end(scratch);
+    return found && S_ISDIR(st.st_mode);
 }
 
-FileIter *platform_file_iter_begin(Arena *arena, String path, u32 flags)
+inline b32 platform_dir_create(Arena *arena, String path)
 {
-    FileIter *iter = arena_push_array(arena, 1, FileIter);
-    iter->flags = flags;
-    iter->data.dir = opendir(string_to_cstring(arena, path));
-    return iter;
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    b32 created = mkdir(string_to_cstring(scratch.arena, path), 0755) == 0 || errno == EEXIST;
+    arena_scratch_end(scratch);
+    return created;
 }
 
-b32 platform_file_iter_next(Arena *arena, FileIter *iter, FileInfo *info)
+b32 platform_file_stat(Arena *arena, String path, FileStat *out)
 {
-    unused(arena);
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    struct stat st;
+    b32 found = stat(string_to_cstring(scratch.arena, path), &st) == 0;
+    arena_scratch_end(scratch);
+    if (!found) {
+        return false;
+    }
+
+    *out = (FileStat){
+        .is_dir = S_ISDIR(st.st_mode),
+        .size = (u64)st.st_size,
+        .mtime = (u64)st.st_mtim.tv_sec * 1000000000 + (u64)st.st_mtim.tv_nsec,
+    };
+    return true;
+}
+
+#if defined(LINUX_HAS_IO_URING)
+typedef struct {
+    i32 descriptor;
+    u32 entries;
+
+    u8 *sq_ring;
+    usize sq_ring_size;
+    u32 *sq_tail;
+    u32 sq_mask;
+    u32 *sq_array;
+    struct io_uring_sqe *sqes;
+    usize sqes_size;
+
+    u8 *cq_ring; // NOTE(cya): same as `sq_ring` with IORING_FEAT_SINGLE_MMAP
+    usize cq_ring_size;
+    u32 *cq_head;
+    u32 *cq_tail;
+    u32 cq_mask;
+    struct io_uring_cqe *cqes;
+} LinuxUring;
+
+internal void linux_uring_release(LinuxUring *ring)
+{
+    if (ring->sqes != NULL && ring->sqes != MAP_FAILED) {
+        munmap(ring->sqes, ring->sqes_size);
+    }
+
+    if (ring->cq_ring != NULL && ring->cq_ring != MAP_FAILED && ring->cq_ring != ring->sq_ring) {
+        munmap(ring->cq_ring, ring->cq_ring_size);
+    }
+
+    if (ring->sq_ring != NULL && ring->sq_ring != MAP_FAILED) {
+        munmap(ring->sq_ring, ring->sq_ring_size);
+    }
 
-    while (iter->data.dir != NULL) {
-        iter->data.entry = readdir(iter->data.dir);
-        if (iter->data.entry == NULL) {
+    close(ring->descriptor);
+}
+
+// NOTE(cya): fails where io_uring is missing or filtered out (seccomp, the
+// io_uring_disabled sysctl), callers fall back to plain syscalls then
+internal b32 linux_uring_init(LinuxUring *ring, u32 entries)
+{
+    struct io_uring_params params = {0};
+    i32 descriptor = (i32)syscall(__NR_io_uring_setup, entries, &params);
+    if (descriptor < 0) {
+        return false;
+    }
+
+    *ring = (LinuxUring){
+        .descriptor = descriptor,
+        .entries = params.sq_entries,
+        .sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(u32),
+        .cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe),
+        .sqes_size = params.sq_entries * sizeof(struct io_uring_sqe),
+    };
+
+    b32 is_single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (is_single_mmap) {
+        ring->sq_ring_size = max(ring->sq_ring_size, ring->cq_ring_size);
+        ring->cq_ring_size = ring->sq_ring_size;
+    }
+
+    i32 prot = PROT_READ | PROT_WRITE;
+    i32 flags = MAP_SHARED | MAP_POPULATE;
+    ring->sq_ring = mmap(NULL, ring->sq_ring_size, prot, flags, descriptor, IORING_OFF_SQ_RING);
+    ring->cq_ring = is_single_mmap ? ring->sq_ring :
+        mmap(NULL, ring->cq_ring_size, prot, flags, descriptor, IORING_OFF_CQ_RING);
+    ring->sqes = mmap(NULL, ring->sqes_size, prot, flags, descriptor, IORING_OFF_SQES);
+    if (ring->sq_ring == MAP_FAILED || ring->cq_ring == MAP_FAILED || ring->sqes == MAP_FAILED) {
+        linux_uring_release(ring);
+        return false;
+    }
+
+    ring->sq_tail = (u32 *)&ring->sq_ring[params.sq_off.tail];
+    ring->sq_mask = *(u32 *)&ring->sq_ring[params.sq_off.ring_mask];
+    ring->sq_array = (u32 *)&ring->sq_ring[params.sq_off.array];
+    ring->cq_head = (u32 *)&ring->cq_ring[params.cq_off.head];
+    ring->cq_tail = (u32 *)&ring->cq_ring[params.cq_off.tail];
+    ring->cq_mask = *(u32 *)&ring->cq_ring[params.cq_off.ring_mask];
+    ring->cqes = (struct io_uring_cqe *)&ring->cq_ring[params.cq_off.cqes];
+    return true;
+}
+
+internal inline i32 linux_uring_enter(LinuxUring *ring, u32 to_submit, u32 min_complete)
+{
+    i32 result;
+    do {
+        result = (i32)syscall(
+            __NR_io_uring_enter,
+            ring->descriptor,
+            to_submit,
+            min_complete,
+            IORING_ENTER_GETEVENTS,
+            NULL,
+            0
+        );
+    } while (result < 0 && errno == EINTR);
+
+    return result;
+}
+
+internal inline void linux_stat_from_statx(struct statx *st, FileStat *out)
+{
+    *out = (FileStat){
+        .is_dir = S_ISDIR(st->stx_mode),
+        .size = st->stx_size,
+        .mtime = (u64)st->stx_mtime.tv_sec * 1000000000 + (u64)st->stx_mtime.tv_nsec,
+    };
+}
+
+// NOTE(cya): judged by the first path (or its directory, when it's missing);
+// batches come from one project or one JDK root list
+internal b32 linux_is_remote_fs(Arena *arena, String path)
+{
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    struct statfs st;
+    b32 found = statfs(string_to_cstring(scratch.arena, path), &st) == 0 ||
+        statfs(string_to_cstring(scratch.arena, string_path_pop_element(path)), &st) == 0;
+    arena_scratch_end(scratch);
+    if (!found) {
+        return false;
+    }
+
+    i64 magics[] = LINUX_REMOTE_FS_MAGICS;
+    for (usize i = 0; i < array_len(magics); i++) {
+        if ((i64)st.f_type == magics[i]) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// NOTE(cya): one ring's worth of statx at a time, submitted with a single
+// io_uring_enter. The kernel runs them on its own workers, so slow file
+// systems (NFS homes) overlap the round trips instead of paying each in turn
+void platform_file_stat_batch(Arena *arena, FileStatEntry *entries, usize count)
+{
+    LinuxUring ring;
+    b32 use_ring = count >= LINUX_URING_MIN_BATCH &&
+        linux_is_remote_fs(arena, entries[0].path) &&
+        linux_uring_init(&ring, LINUX_URING_ENTRIES);
+    if (!use_ring) {
+        platform_file_stat_each(arena, entries, count);
+        return;
+    }
+
+    // NOTE(cya): what the kernel reads (paths) and writes (results) gets its own
+    // arena, which only goes away once everything submitted has completed
+    Arena inflight = arena_init(16, kibibytes(64), 0);
+    if (inflight.memory == NULL) {
+        linux_uring_release(&ring);
+        platform_file_stat_each(arena, entries, count);
+        return;
+    }
+
+    struct statx *results = arena_push_array(&inflight, ring.entries, struct statx);
+    usize paths_pos = arena_pos(&inflight);
+    b32 is_drained = true;
+    usize base = 0;
+    while (base < count) {
+        arena_pop_to(&inflight, paths_pos);
+        u32 queued = (u32)min(count - base, (usize)ring.entries);
+        u32 sq_tail = *ring.sq_tail;
+        for (u32 i = 0; i < queued; i++) {
+            u32 index = sq_tail & ring.sq_mask;
+            struct io_uring_sqe *sqe = &ring.sqes[index];
+            *sqe = (struct io_uring_sqe){0};
+            sqe->opcode = IORING_OP_STATX;
+            sqe->fd = AT_FDCWD;
+            sqe->addr = (u64)(uptr)string_to_cstring(&inflight, entries[base + i].path);
+            sqe->len = STATX_TYPE | STATX_SIZE | STATX_MTIME;
+            sqe->off = (u64)(uptr)&results[i];
+            sqe->user_data = i;
+            ring.sq_array[index] = index;
+            sq_tail += 1;
+        }
+
+        __atomic_store_n(ring.sq_tail, sq_tail, __ATOMIC_RELEASE);
+
+        // NOTE(cya): the kernel may take fewer than asked for (out of memory,
+        // say); SQEs are consumed in order, so the rest are the tail
+        u32 submitted = 0;
+        while (submitted < queued) {
+            i32 result = linux_uring_enter(&ring, queued - submitted, 0);
+            if (result <= 0) {
+                break;
+            }
+
+            submitted += (u32)result;
+        }
+
+        u32 completed = 0;
+        while (completed < submitted) {
+            u32 cq_head = *ring.cq_head;
+            u32 cq_tail = __atomic_load_n(ring.cq_tail, __ATOMIC_ACQUIRE);
+            if (cq_head == cq_tail) {
+                if (linux_uring_enter(&ring, 0, 1) < 0) {
+                    is_drained = false;
+                    break;
+                }
+
+                continue;
+            }
+
+            for (; cq_head != cq_tail; cq_head++, completed++) {
+                struct io_uring_cqe *cqe = &ring.cqes[cq_head & ring.cq_mask];
+                FileStatEntry *entry = &entries[base + cqe->user_data];
+                i32 result = cqe->res;
+                if (result == 0) {
+                    entry->exists = true;
+                    linux_stat_from_statx(&results[cqe->user_data], &entry->stat);
+                } else if (result == -EINVAL || result == -EOPNOTSUPP) {
+                    // NOTE(cya): kernels before 5.6 don't know the opcode
+                    entry->exists = platform_file_stat(arena, entry->path, &entry->stat);
+                } else {
+                    entry->exists = false;
+                }
+            }
+
+            __atomic_store_n(ring.cq_head, cq_head, __ATOMIC_RELEASE);
+        }
+
+        if (!is_drained) {
             break;
         }
 
-        const char *name = iter->data.entry->d_name;
-        struct stat st;
-        stat(name, &st);
+        // NOTE(cya): unsubmitted SQEs are still sitting in the ring, it can't
+        // be used for another round
+        for (u32 i = submitted; i < queued; i++) {
+            FileStatEntry *entry = &entries[base + i];
+            entry->exists = platform_file_stat(arena, entry->path, &entry->stat);
+        }
 
-        b32 is_dir = (st.st_mode & S_IFMT) == S_IFDIR;
-        b32 skip = ((iter->flags & FILE_ITER_SKIP_DIRS) && is_dir) ||
-            ((iter->flags & FILE_ITER_SKIP_FILES) && !is_dir) ||
-            ((iter->flags & FILE_ITER_SKIP_HIDDEN) && name[0] == '.');
-        if (skip) {
-            continue;
+        base += queued;
+        if (submitted < queued) {
+            break;
         }
+    }
 
-        info->name = string_from_cstring(name);
-        return true;
+    if (is_drained) {
+        arena_release(&inflight);
+        linux_uring_release(&ring);
+    } else {
+        // NOTE(cya): statx calls still in flight may write to it at any time,
+        // so the memory (and the ring) are left alone for good
+        log_debug("unable to wait on io_uring completions, leaking the batch");
     }
 
-    iter->is_done = true;
-    return false;
+    if (base < count) {
+        platform_file_stat_each(arena, &entries[base], count - base);
+    }
+}
+#else
+inline void platform_file_stat_batch(Arena *arena, FileStatEntry *entries, usize count)
+{
+    platform_file_stat_each(arena, entries, count);
+}
+#endif
+
+inline b32 platform_file_rename(Arena *arena, String from, String to)
+{
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    char *from_cstr = string_to_cstring(scratch.arena, from);
+    b32 renamed = rename(from_cstr, string_to_cstring(scratch.arena, to)) == 0;
+    arena_scratch_end(scratch);
+    return renamed;
+}
+
+inline b32 platform_file_delete(Arena *arena, String path)
+{
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    b32 deleted = unlink(string_to_cstring(scratch.arena, path)) == 0;
+    arena_scratch_end(scratch);
+    return deleted;
+}
+
+usize platform_file_read(File file, void *buf, usize size)
+{
+    for (;;) {
+        ssize_t result = read(file.descriptor, buf, size);
+        if (result >= 0) {
+            return (usize)result;
+        }
+
+        if (errno != EINTR) {
+            return 0;
+        }
+    }
+}
+
+FileMapping platform_file_map(Arena *arena, String path)
+{
+    FileMapping mapping = {0};
+    File file = platform_file_open(arena, path);
+    if (!platform_file_is_valid(file)) {
+        return mapping;
+    }
+
+    // NOTE(cya): pipes and /proc files (no size) and small files are read
+    struct stat st;
+    b32 mappable = fstat(file.descriptor, &st) == 0 && S_ISREG(st.st_mode) &&
+        (usize)st.st_size >= PLATFORM_FILE_MAP_MIN_SIZE;
+    if (mappable) {
+        usize size = (usize)st.st_size;
+        int flags = MAP_PRIVATE | MAP_POPULATE;
+        void *data = mmap(NULL, size, PROT_READ, flags, file.descriptor, 0);
+        if (data != MAP_FAILED) {
+            madvise(data, size, MADV_SEQUENTIAL);
+            mapping = (FileMapping){.data = string_create(data, size), .is_mapped = true};
+        }
+    }
+
+    if (!mapping.is_mapped) {
+        mapping.data = platform_file_read_into_string(arena, file);
+    }
+
+    platform_file_close(file);
+    return mapping;
+}
+
+inline void platform_file_unmap(FileMapping *mapping)
+{
+    if (mapping->is_mapped) {
+        munmap(mapping->data.str, mapping->data.len);
+    }
+
+    *mapping = (FileMapping){0};
+}
+
+// NOTE(cya): the kernel's record layout, glibc only wraps it as of 2.30
+typedef struct {
+    u64 d_ino;
+    i64 d_off;
+    u16 d_reclen;
+    u8 d_type;
+    char d_name[];
+} LinuxDirent64;
+
+// NOTE(cya): `arena` is only there to be kept out of, the scratch taken here
+// holds the buffer until platform_file_iter_end
+FileIter platform_file_iter_begin(Arena *arena, String path, u32 flags)
+{
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    int open_flags = O_RDONLY | O_DIRECTORY | O_CLOEXEC;
+    int descriptor = open(string_to_cstring(scratch.arena, path), open_flags);
+    return (FileIter){
+        .flags = flags,
+        .is_done = descriptor == -1,
+        .scratch = scratch,
+        .data = {
+            .descriptor = descriptor,
+            .buf = descriptor == -1 ? NULL : arena_push(scratch.arena, LINUX_DIR_BUFFER_SIZE),
+        },
+    };
+}
+
+// NOTE(cya): d_type settles it except for symlinks (sdkman's `current`, distro
+// JDK aliases) and file systems that don't fill it in
+internal b32 linux_dirent_is_dir(i32 dir, LinuxDirent64 *entry)
+{
+    if (entry->d_type != DT_UNKNOWN && entry->d_type != DT_LNK) {
+        return entry->d_type == DT_DIR;
+    }
+
+    struct stat st;
+    return fstatat(dir, entry->d_name, &st, 0) == 0 && S_ISDIR(st.st_mode);
+}
+
+// NOTE(cya): one getdents64 per buffer full of entries; a batch never spans
+// two reads, since the names point into the buffer
+usize platform_file_iter_next_batch(FileIter *iter, FileInfo *infos, usize cap)
+{
+    PlatformFileIter *data = &iter->data;
+    usize count = 0;
+    while (count < cap && !iter->is_done) {
+        if (data->pos >= data->len) {
+            if (count > 0) {
+                break;
+            }
+
+            long read = syscall(SYS_getdents64, data->descriptor, data->buf, LINUX_DIR_BUFFER_SIZE);
+            if (read <= 0) {
+                iter->is_done = true;
+                break;
+            }
+
+            data->len = (usize)read;
+            data->pos = 0;
+        }
+
+        LinuxDirent64 *entry = (LinuxDirent64*)&data->buf[data->pos];
+        data->pos += entry->d_reclen;
+
+        String name = string_from_cstring(entry->d_name);
+        b32 is_dir = linux_dirent_is_dir(data->descriptor, entry);
+        if (!platform_file_iter_skips(iter, name, is_dir)) {
+            infos[count++] = (FileInfo){.name = name, .is_dir = is_dir};
+        }
+    }
+
+    return count;
+}
+
+inline b32 platform_file_iter_next(FileIter *iter, FileInfo *info)
+{
+    return platform_file_iter_next_batch(iter, info, 1) == 1;
 }
 
 void platform_file_iter_end(FileIter *iter)
 {
-    closedir(iter->data.dir);
+    if (iter->data.descriptor != -1) {
+        close(iter->data.descriptor);
+    }
+
+    arena_scratch_end(iter->scratch);
+}
+
+b32 platform_file_write_string(File file, String s)
+{
+    usize written = 0;
+    while (written < s.len) {
+        ssize_t result = write(file.descriptor, &s.str[written], s.len - written);
+        if (result == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return false;
+        }
+
+        written += (usize)result;
+    }
+
+    return true;
+}
+
+// NOTE(cya): one writev, unless the kernel cuts it short
+b32 platform_file_write_strings(File file, String *parts, usize count)
+{
+    struct iovec iov[PLATFORM_WRITE_MAX_PARTS];
+    assert(count <= array_len(iov));
+    for (usize i = 0; i < count; i++) {
+        iov[i] = (struct iovec){.iov_base = parts[i].str, .iov_len = parts[i].len};
+    }
+
+    usize first = 0;
+    while (first < count) {
+        ssize_t result = writev(file.descriptor, &iov[first], (int)(count - first));
+        if (result == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return false;
+        }
+
+        usize written = (usize)result;
+        for (; first < count && written >= iov[first].iov_len; first++) {
+            written -= iov[first].iov_len;
+        }
+
+        if (first < count) {
+            iov[first].iov_base = (u8*)iov[first].iov_base + written;
+            iov[first].iov_len -= written;
+        }
+    }
+
+    return true;
 }
 
-inline void platform_file_write_string(File file, String s)
+typedef struct {
+    ThreadProc *proc;
+    void *data;
+} LinuxThreadStart;
+
+internal void *linux_thread_entry(void *param)
 {
-    write(file.descriptor, s.str, s.len);
+    LinuxThreadStart *start = param;
+    start->proc(start->data);
+    arena_scratch_release();
+    return NULL;
 }
 
-#define ERROR_STATUS 255
+Thread platform_thread_start(Arena *arena, ThreadProc *proc, void *data)
+{
+    LinuxThreadStart *start = arena_push_array(arena, 1, LinuxThreadStart);
+    *start = (LinuxThreadStart){.proc = proc, .data = data};
 
+    Thread thread = {0};
+    thread.started = pthread_create(&thread.handle, NULL, linux_thread_entry, start) == 0;
+    return thread;
+}
+
+inline void platform_thread_join(Thread thread)
+{
+    if (thread.started) {
+        pthread_join(thread.handle, NULL);
+    }
+}
+
+inline u32 platform_get_processor_count(void)
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count < 1 ? 1 : (u32)count;
+}
+
+// NOTE(cya): monotonic, only meaningful as a difference
+inline u64 platform_get_time_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (u64)now.tv_sec * 1000000000ull + (u64)now.tv_nsec;
+}
+
+// NOTE(cya): exec failures come back through a close-on-exec pipe, so every
+// exit status the child can produce is passed through untouched
 inline Process platform_process_spawn(Arena *arena, CommandLine *cmd_line)
 {
+    int argc;
+    char **argv = command_line_to_argv(arena, cmd_line, &argc);
+
+    int error_pipe[2];
+    if (pipe2(error_pipe, O_CLOEXEC) == -1) {
+        return (Process){.pid = -1};
+    }
+
     pid_t pid = fork();
     if (pid == 0) {
         // NOTE(cya): child process branch
-        int argc;
-        char **argv = command_line_to_argv(arena, cmd_line, &argc);
+        close(error_pipe[0]);
         execv(argv[0], argv);
-        _exit(ERROR_STATUS); // NOTE(cya): if we get down here it's because exec failed
+
+        int error = errno;
+        ssize_t written;
+        do {
+            written = write(error_pipe[1], &error, sizeof(error));
+        } while (written == -1 && errno == EINTR);
+        _exit(127);
+    }
+
+    close(error_pipe[1]);
+    if (pid == -1) {
+        int error = errno;
+        close(error_pipe[0]);
+        errno = error;
+        return (Process){.pid = -1};
+    }
+
+    // NOTE(cya): EOF means exec went through and the pipe was closed with it
+    int error;
+    ssize_t read_len;
+    do {
+        read_len = read(error_pipe[0], &error, sizeof(error));
+    } while (read_len == -1 && errno == EINTR);
+    close(error_pipe[0]);
+
+    if (read_len == sizeof(error)) {
+        pid_t status;
+        do {
+            status = waitpid(pid, NULL, 0);
+        } while (status == -1 && errno == EINTR);
+        errno = error;
+        return (Process){.pid = -1};
     }
 
     return (Process){.pid = pid};
 }
 
+inline b32 platform_process_exec(Arena *arena, CommandLine *cmd_line)
+{
+    // NOTE(cya): replaces our image, so this only returns on failure
+    int argc;
+    char **argv = command_line_to_argv(arena, cmd_line, &argc);
+    execve(argv[0], argv, environ);
+    return false;
+}
+
 inline b32 platform_process_failed(Process process)
 {
     return process.pid == -1;
 }
 
-inline b32 platform_process_await(Process process)
+inline b32 platform_process_await(Process process, i32 *out_exit_code)
 {
     if (platform_process_failed(process)) {
         return false;
@@ -154,13 +744,24 @@ inline b32 platform_process_await(Process process)
 
     int w_status;
     do {
-        pid_t status = waitpid(process.pid, &w_status, WUNTRACED | WCONTINUED);
+        pid_t status = waitpid(process.pid, &w_status, 0);
         if (status == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+
             return false;
         }
-    } while (!WIFEXITED(w_status));
+    } while (!WIFEXITED(w_status) && !WIFSIGNALED(w_status));
+
+    // NOTE(cya): same convention as the shell for children killed by a signal
+    i32 exit_code = WIFEXITED(w_status) ?
+        WEXITSTATUS(w_status) : 128 + WTERMSIG(w_status);
+    if (out_exit_code != NULL) {
+        *out_exit_code = exit_code;
+    }
 
-    return WEXITSTATUS(w_status) != ERROR_STATUS;
+    return true;
 }
 
 thread_local u8 __linux_error_buf[4096];
@@ -188,9 +789,179 @@ inline String platform_get_home_directory(Arena *arena)
     return platform_get_env(arena, string_lit("HOME"));
 }
 
+String platform_get_current_directory(Arena *arena)
+{
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    char *buf = arena_push(scratch.arena, PATH_MAX);
+    String result = getcwd(buf, PATH_MAX) == NULL ?
+        string_lit("") : string_copy(arena, string_from_cstring(buf));
+    arena_scratch_end(scratch);
+    return result;
+}
+
+String platform_get_cache_directory(Arena *arena)
+{
+    String cache_home = platform_get_env(arena, string_lit("XDG_CACHE_HOME"));
+    if (!string_is_empty(cache_home)) {
+        return cache_home;
+    }
+
+    String home = platform_get_home_directory(arena);
+    return string_is_empty(home) ? home : string_path_append(arena, home, string_lit(".cache"));
+}
+
+inline u32 platform_get_process_id(void)
+{
+    return (u32)getpid();
+}
+
+// NOTE(cya): absolute path with every symlink and `.`/`..` resolved
+String platform_path_resolve(Arena *arena, String path)
+{
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    char *buf = arena_push(scratch.arena, PATH_MAX);
+    String result = realpath(string_to_cstring(scratch.arena, path), buf) == NULL ?
+        string_lit("") : string_copy(arena, string_from_cstring(buf));
+    arena_scratch_end(scratch);
+    return result;
+}
+
+inline PathKind platform_path_builder_kind(PathBuilder *path)
+{
+    struct stat st;
+    if (stat((char *)path->buf, &st) != 0) {
+        return PATH_KIND_NONE;
+    }
+
+    return S_ISDIR(st.st_mode) ? PATH_KIND_DIR :
+        S_ISREG(st.st_mode) ? PATH_KIND_FILE : PATH_KIND_NONE;
+}
+
+internal inline b32 linux_path_dir_equals(PlatformPathDir *a, PlatformPathDir *b)
+{
+    return a->device == b->device && a->inode == b->inode;
+}
+
+// NOTE(cya): lookups walk the list in order, so everything before `dir` has
+// already been opened by the time it's compared against
+internal void linux_path_probe_open(PathProbe *probe, PathProbeDir *dir)
+{
+    dir->is_opened = true;
+    dir->is_skipped = true;
+    dir->data.descriptor = -1;
+
+    PathBuilder path;
+    platform_path_builder_set(&path, dir->path);
+    if (path.overflowed) {
+        return;
+    }
+
+    i32 descriptor = open((char *)path.buf, O_PATH | O_DIRECTORY | O_CLOEXEC);
+    if (descriptor == -1) {
+        return;
+    }
+
+    struct stat st;
+    if (fstat(descriptor, &st) != 0) {
+        close(descriptor);
+        return;
+    }
+
+    PlatformPathDir data = {
+        .descriptor = descriptor,
+        .device = (u64)st.st_dev,
+        .inode = (u64)st.st_ino,
+    };
+    b32 is_duplicate = probe->has_excluded && linux_path_dir_equals(&data, &probe->excluded);
+    for (PathProbeDir *prev = probe->dirs; prev < dir && !is_duplicate; prev++) {
+        is_duplicate = !prev->is_skipped && linux_path_dir_equals(&data, &prev->data);
+    }
+
+    if (is_duplicate) {
+        close(descriptor);
+        return;
+    }
+
+    dir->data = data;
+    dir->is_skipped = false;
+}
+
+// NOTE(cya): execvp passes over directories (and anything else that isn't a
+// regular file) however their permission bits look
+internal b32 linux_path_dir_has_executable(PlatformPathDir *dir, char *name)
+{
+    struct stat st;
+    return fstatat(dir->descriptor, name, &st, 0) == 0 && S_ISREG(st.st_mode) &&
+        faccessat(dir->descriptor, name, X_OK, 0) == 0;
+}
+
+// NOTE(cya): the directory `file` was found in, executable, the way execvp
+// would pick it
+String platform_path_probe_find(PathProbe *probe, String file)
+{
+    PathBuilder name;
+    platform_path_builder_set(&name, file);
+    if (name.overflowed) {
+        return string_lit("");
+    }
+
+    for (usize i = 0; i < probe->count; i++) {
+        PathProbeDir *dir = &probe->dirs[i];
+        if (!dir->is_opened) {
+            linux_path_probe_open(probe, dir);
+        }
+
+        if (!dir->is_skipped && linux_path_dir_has_executable(&dir->data, (char *)name.buf)) {
+            return dir->path;
+        }
+    }
+
+    return string_lit("");
+}
+
+void platform_path_probe_exclude(PathProbe *probe, String dir)
+{
+    PathBuilder path;
+    platform_path_builder_set(&path, dir);
+    struct stat st;
+    if (path.overflowed || stat((char *)path.buf, &st) != 0) {
+        return;
+    }
+
+    probe->excluded = (PlatformPathDir){
+        .descriptor = -1,
+        .device = (u64)st.st_dev,
+        .inode = (u64)st.st_ino,
+    };
+    probe->has_excluded = true;
+    for (usize i = 0; i < probe->count; i++) {
+        PathProbeDir *entry = &probe->dirs[i];
+        if (!entry->is_skipped && entry->is_opened &&
+            linux_path_dir_equals(&entry->data, &probe->excluded)) {
+            close(entry->data.descriptor);
+            entry->data.descriptor = -1;
+            entry->is_skipped = true;
+        }
+    }
+}
+
+void platform_path_probe_release(PathProbe *probe)
+{
+    for (usize i = 0; i < probe->count; i++) {
+        PathProbeDir *dir = &probe->dirs[i];
+        if (dir->is_opened && !dir->is_skipped) {
+            close(dir->data.descriptor);
+        }
+
+        dir->is_opened = false;
+        dir->is_skipped = false;
+    }
+}
+
 int main(int argc, char *argv[])
 {
     PLATFORM_PAGE_SIZE = platform_get_page_size();
+    cpu_features_init();
 
     __platform_std_files[STDIN].descriptor = STDIN;
     __platform_std_files[STDOUT].descriptor = STDOUT;
@@ -201,18 +972,18 @@ int main(int argc, char *argv[])
         return 1;
     }
 
-    StringList arguments = {0};
-    for (int i = 0; i < argc; i++) {
-        String argument = string_from_cstring(argv[i]);
-        string_list_push_back(&arena, &arguments, argument);
-    }
+    StringArray argument_array = string_array_from_cstrings(&arena, argv, (usize)argc);
+    StringList arguments = string_array_to_list(&arena, &argument_array);
 
-    log.arena = &arena;
+    log_init(&arena);
 
     CommandLine cmd_line = command_line_from_string_list(&arguments);
-    entry_point(&arena, &cmd_line);
+    i32 exit_code = entry_point(&arena, &cmd_line);
 
 #if defined(BUILD_DEBUG)
     arena_log_stats(&arena);
 #endif
+
+    log_flush();
+    return exit_code;
 }
@@ -3,11 +3,28 @@
 #include <errno.h> // errno
 #include <string.h> // strerror
 #include <stdlib.h> // getenv, setenv
-#include <dirent.h> // opendir
+#include <stdio.h> // rename
+#include <dirent.h> // DT_DIR
 #include <limits.h> // PATH_MAX
 #include <sys/stat.h> // stat
 #include <sys/wait.h> // wait
 #include <sys/mman.h> // mmap
+#include <sys/uio.h> // writev
+#include <sys/vfs.h> // statfs
+#include <pthread.h> // pthread_create
+#include <time.h> // clock_gettime
+#include <sys/syscall.h> // SYS_getdents64
+
+// NOTE(cya): older kernel headers don't have it, batches are done one at a
+// time there
+#if defined(__has_include)
+#    if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#        include <linux/io_uring.h> // io_uring_sqe
+#        define LINUX_HAS_IO_URING 1
+#    endif
+#endif
+
+extern char **environ;
 
 typedef struct {
     usize size;
@@ -19,24 +36,62 @@ typedef struct {
 } Process;
 
 typedef struct {
-    DIR *dir;
-    struct dirent *entry;
+    pthread_t handle;
+    b32 started;
+} Thread;
+
+// NOTE(cya): raw getdents64 records, a buffer full at a time
+typedef struct {
+    i32 descriptor;
+    u8 *buf;
+    usize len;
+    usize pos;
 } PlatformFileIter;
 
+#define LINUX_DIR_BUFFER_SIZE kibibytes(32)
+
+// NOTE(cya): an O_PATH handle, lookups go through the *at calls; the inode is
+// what tells symlinked spellings of the same directory apart
+typedef struct {
+    i32 descriptor;
+    u64 device;
+    u64 inode;
+} PlatformPathDir;
+
+// NOTE(cya): below this setting a ring up costs more than the stats it saves
+#define LINUX_URING_MIN_BATCH 16
+// NOTE(cya): statx always runs on io_uring's workers; that only pays off
+// where each stat is a round trip (NFS, SMB/CIFS, Ceph, AFS, 9p, FUSE)
+#define LINUX_REMOTE_FS_MAGICS { \
+    0x6969, 0xff534d42, 0xfe534d42, 0x517b, 0x00c36400, \
+    0x5346414f, 0x01021997, 0x65735546, \
+}
+#define LINUX_URING_ENTRIES 256
+
 #if !defined(MAP_ANONYMOUS)
 #    define MAP_ANONYMOUS MAP_ANON
 #endif
 
 #define PLATFORM_PATH_SEPARATOR "/"
+#define PLATFORM_PATH_MAX PATH_MAX
 #define PLATFORM_LINE_SEPARATOR "\n"
 #define PLATFORM_ENV_SEPARATOR ":"
 
 #define PLATFORM_SHELL_NAME "/bin/sh"
-#define PLATFORM_SHELL_CMD_FLAG "-c"
+// NOTE(cya): the shell runs the launcher script file directly (no `-c`), so
+// the arguments following it are passed through as positional parameters
+#define PLATFORM_SHELL_CMD_FLAG ""
 
 #define PLATFORM_MVN_FILE string_lit("mvn")
+#define PLATFORM_JAVA_FILE string_lit("java")
+#define PLATFORM_JDK_SYSTEM_DIRS {"/usr/lib/jvm", "/usr/java", "/opt/java"}
+// NOTE(cya): what the mvn script sources unless MAVEN_SKIP_RC is set, the user
+// ones relative to the home directory
+#define PLATFORM_MAVEN_RC_FILES {"/usr/local/etc/mavenrc", "/etc/mavenrc"}
+#define PLATFORM_MAVEN_USER_RC_FILES {".mavenrc"}
 
 #define platform_mem_equal(a, b, len) (memcmp(a, b, len) == 0)
 #define platform_mem_copy(d, s, len) memcpy(d, s, len)
+#define platform_mem_move(d, s, len) memmove(d, s, len)
 
 #define platform_file_is_valid(f) ((f).descriptor != -1)
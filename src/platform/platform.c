@@ -1,3 +1,38 @@
+// NOTE(cya): `.` and `..` are never reported
+internal inline b32 platform_file_iter_skips(FileIter *iter, String name, b32 is_dir)
+{
+    b32 is_dot = string_equals(name, string_lit(".")) || string_equals(name, string_lit(".."));
+    return is_dot ||
+        ((iter->flags & FILE_ITER_SKIP_DIRS) && is_dir) ||
+        ((iter->flags & FILE_ITER_SKIP_FILES) && !is_dir) ||
+        ((iter->flags & FILE_ITER_SKIP_HIDDEN) && name.len > 0 && name.str[0] == '.');
+}
+
+// NOTE(cya): an empty entry is the current directory; trailing separators go,
+// except where they're what makes it a root (`/`, `C:\`)
+internal inline String platform_path_trim_separators(String path)
+{
+    if (string_is_empty(path)) {
+        return string_lit(".");
+    }
+
+    u8 separator = PLATFORM_PATH_SEPARATOR[0];
+    while (path.len > 1 && path.str[path.len - 1] == separator &&
+        path.str[path.len - 2] != ':') {
+        path.len -= 1;
+    }
+
+    return path;
+}
+
+// NOTE(cya): what a batch stat comes down to without a way to overlap them
+internal inline void platform_file_stat_each(Arena *arena, FileStatEntry *entries, usize count)
+{
+    for (usize i = 0; i < count; i++) {
+        entries[i].exists = platform_file_stat(arena, entries[i].path, &entries[i].stat);
+    }
+}
+
 // TODO(cya): mac(?)
 #if defined(PLATFORM_WINDOWS)
 #    include "win32/platform_core_win32.c"
@@ -7,27 +42,205 @@
 #    error platform layer not implemented for this OS
 #endif
 
-// NOTE(cya): we don't really need more than one for this
+// NOTE(cya): we don't really need more than one for this; the reserve is
+// only address space, and past it the arena chains in more blocks
 inline Arena platform_init_main_arena(void)
 {
-    Arena arena = arena_init(16, kibibytes(64));
+    Arena arena = arena_init(1024, kibibytes(64), ARENA_NO_RESERVE);
     if (arena.memory == NULL) {
         String error = platform_get_error_message(platform_get_last_error());
-        log_fatal("unable to acquire virtual memory: {}", error);
+        assert_fatal("unable to acquire virtual memory: {}", error);
+
     }
 
     return arena;
 }
 
-inline String platform_find_first_file(Arena *arena, StringList *path_list, String file)
+internal inline void platform_path_builder_append(PathBuilder *builder, String s)
+{
+    if (builder->overflowed || builder->len + s.len >= sizeof(builder->buf)) {
+        builder->overflowed = true;
+        return;
+    }
+
+    mem_copy(&builder->buf[builder->len], s.str, s.len);
+    builder->len += s.len;
+    builder->buf[builder->len] = '\0';
+}
+
+inline void platform_path_builder_set(PathBuilder *builder, String path)
 {
-    string_list_foreach(path_list, node) {
-        String path = node->str;
-        String full_path = string_path_append(arena, path, file);
-        if (platform_file_exists(arena, full_path)) {
-            return path;
+    builder->len = 0;
+    builder->buf[0] = '\0';
+    builder->overflowed = false;
+    platform_path_builder_append(builder, path);
+}
+
+inline void platform_path_builder_push(PathBuilder *builder, String element)
+{
+    u8 separator = PLATFORM_PATH_SEPARATOR[0];
+    if (builder->len > 0 && builder->buf[builder->len - 1] != separator) {
+        platform_path_builder_append(builder, string_lit(PLATFORM_PATH_SEPARATOR));
+    }
+
+    platform_path_builder_append(builder, element);
+}
+
+// NOTE(cya): back to an earlier length, undoing whatever was pushed since
+inline void platform_path_builder_truncate(PathBuilder *builder, usize len)
+{
+    builder->len = len;
+    builder->buf[len] = '\0';
+    builder->overflowed = false;
+}
+
+// NOTE(cya): the closest of `start` and its parents that holds a `marker` of
+// the given kind, as a prefix of `start` (empty when none does)
+String platform_path_find_upwards(String start, String marker, PathKind kind)
+{
+    PathBuilder path;
+    platform_path_builder_set(&path, start);
+    if (path.overflowed) {
+        return string_lit("");
+    }
+
+    for (String dir = start; !string_is_empty(dir); dir = string_path_pop_element(dir)) {
+        platform_path_builder_truncate(&path, dir.len);
+        platform_path_builder_push(&path, marker);
+        if (!path.overflowed && platform_path_builder_kind(&path) == kind) {
+            return dir;
         }
     }
 
     return string_lit("");
 }
+
+PathProbe platform_path_probe_init(Arena *arena, StringArray *dirs)
+{
+    StringArray paths = string_array_init(arena, dirs->count);
+    for (usize i = 0; i < dirs->count; i++) {
+        string_array_push(arena, &paths, platform_path_trim_separators(dirs->items[i]));
+    }
+
+    string_array_dedup(arena, &paths);
+
+    PathProbe probe = {
+        .dirs = arena_push_array(arena, paths.count, PathProbeDir),
+        .count = paths.count,
+    };
+    for (usize i = 0; i < paths.count; i++) {
+        probe.dirs[i] = (PathProbeDir){.path = paths.items[i]};
+    }
+
+    return probe;
+}
+
+// NOTE(cya): reads until EOF, the size is only a hint (pipes and /proc files
+// don't report one)
+String platform_file_read_into_string(Arena *arena, File file)
+{
+    // NOTE(cya): one spare byte so that the EOF read doesn't force a regrow
+    usize cap = file.size > 0 ? file.size + 1 : kibibytes(4);
+    u8 *buf = arena_push(arena, cap);
+    usize len = 0;
+    for (;;) {
+        if (len == cap) {
+            u8 *grown = arena_push(arena, cap * 2);
+            mem_copy(grown, buf, len);
+            buf = grown;
+            cap *= 2;
+        }
+
+        usize read = platform_file_read(file, &buf[len], cap - len);
+        if (read == 0) {
+            break;
+        }
+
+        len += read;
+    }
+
+    return string_create(buf, len);
+}
+
+inline FileStream platform_file_stream_open(Arena *arena, String path, u8 *buf, usize cap)
+{
+    File file = platform_file_open(arena, path);
+    return (FileStream){
+        .file = file,
+        .buf = buf,
+        .cap = cap,
+        .eof = !platform_file_is_valid(file),
+    };
+}
+
+// NOTE(cya): drops the first `consumed` bytes of the window and tops it up
+// again; strings pointing into the previous window don't survive this
+String platform_file_stream_refill(FileStream *stream, usize consumed)
+{
+    usize kept = stream->len - min(consumed, stream->len);
+    mem_move(stream->buf, &stream->buf[stream->len - kept], kept);
+    stream->len = kept;
+    while (!stream->eof && stream->len < stream->cap) {
+        usize space = stream->cap - stream->len;
+        usize read = platform_file_read(stream->file, &stream->buf[stream->len], space);
+        if (read == 0) {
+            stream->eof = true;
+        }
+
+        stream->len += read;
+    }
+
+    return string_create(stream->buf, stream->len);
+}
+
+inline void platform_file_stream_close(FileStream *stream)
+{
+    if (platform_file_is_valid(stream->file)) {
+        platform_file_close(stream->file);
+    }
+
+    stream->eof = true;
+}
+
+String platform_file_read_entire(Arena *arena, String path)
+{
+    File file = platform_file_open(arena, path);
+    if (!platform_file_is_valid(file)) {
+        return string_lit("");
+    }
+
+    String result = platform_file_read_into_string(arena, file);
+    platform_file_close(file);
+    return result;
+}
+
+// NOTE(cya): readers only ever see the old or the new contents, never a mix
+b32 platform_file_write_atomic(Arena *arena, String path, String data)
+{
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    u64 pid = platform_get_process_id();
+    String tmp_path = string_fmt(scratch.arena, "{}.{u}.tmp", path, pid);
+    File file = platform_file_create(scratch.arena, tmp_path);
+    b32 is_stored = platform_file_is_valid(file);
+    if (is_stored) {
+        b32 written = platform_file_write_string(file, data);
+        b32 closed = platform_file_close(file);
+        is_stored = written && closed && platform_file_rename(scratch.arena, tmp_path, path);
+        if (!is_stored) {
+            platform_file_delete(scratch.arena, tmp_path);
+        }
+    }
+
+    arena_scratch_end(scratch);
+    return is_stored;
+}
+
+b32 platform_dir_create_all(Arena *arena, String path)
+{
+    if (string_is_empty(path) || platform_dir_exists(arena, path)) {
+        return true;
+    }
+
+    String parent = string_path_pop_element(path);
+    return platform_dir_create_all(arena, parent) && platform_dir_create(arena, path);
+}
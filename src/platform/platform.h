@@ -21,44 +21,157 @@ typedef enum {
     FILE_ITER_SKIP_HIDDEN = 1 << 2,
 } FileIterFlags;
 
+typedef enum {
+    PATH_KIND_NONE, // NOTE(cya): missing, or something other than the two below
+    PATH_KIND_FILE,
+    PATH_KIND_DIR,
+} PathKind;
+
+typedef enum {
+    PLATFORM_MEM_HUGE_PAGES = 1 << 0,
+    PLATFORM_MEM_NO_RESERVE = 1 << 1,
+} PlatformMemFlags;
+
+// NOTE(cya): `name` may point into the iterator, it's only valid until the
+// next call on it
 typedef struct {
     String name;
+    b32 is_dir; // NOTE(cya): symlinks are followed
 } FileInfo;
 
+typedef struct {
+    b32 is_dir;
+    u64 size;
+    u64 mtime; // NOTE(cya): nanoseconds, only meaningful for comparisons
+} FileStat;
+
+// NOTE(cya): one path of a batch stat, `stat` is only filled in when it exists
+typedef struct {
+    String path;
+    FileStat stat;
+    b32 exists;
+} FileStatEntry;
+
+// NOTE(cya): owned by the caller; whatever the platform needs on top (buffers,
+// converted names) lives in a scratch arena held until platform_file_iter_end
 typedef struct {
     u32 flags;
     b32 is_done;
+    ArenaTemp scratch;
     PlatformFileIter data;
 } FileIter;
 
+typedef struct {
+    String data;
+    b32 is_mapped; // NOTE(cya): false when it had to be read into the arena
+} FileMapping;
+
+// NOTE(cya): a window over the file in a caller-owned buffer, for readers that
+// may stop before the end (or shouldn't keep the whole file around)
+typedef struct {
+    File file;
+    u8 *buf;
+    usize cap;
+    usize len;
+    b32 eof;
+} FileStream;
+
+// NOTE(cya): a NUL-terminated path assembled in place, so that probing a
+// candidate doesn't cost an allocation
+typedef struct {
+    u8 buf[PLATFORM_PATH_MAX];
+    usize len;
+    b32 overflowed; // NOTE(cya): something didn't fit, don't probe the result
+} PathBuilder;
+
+typedef struct {
+    String path; // NOTE(cya): as listed, minus trailing separators
+    b32 is_opened;
+    b32 is_skipped; // NOTE(cya): missing, excluded or a duplicate
+    PlatformPathDir data;
+} PathProbeDir;
+
+// NOTE(cya): a PATH-like list of directories to look executables up in.
+// Entries are only opened once a lookup reaches them, and kept open for the
+// next one
+typedef struct {
+    PathProbeDir *dirs;
+    usize count;
+    PlatformPathDir excluded;
+    b32 has_excluded;
+} PathProbe;
+
+// NOTE(cya): below this a plain read is cheaper than setting up a mapping
+#define PLATFORM_FILE_MAP_MIN_SIZE kibibytes(16)
+#define PLATFORM_WRITE_MAX_PARTS 8 // NOTE(cya): per platform_file_write_strings call
+
+typedef void ThreadProc(void *data);
+
 #define platform_get_std_file(d) __platform_std_files[(d)]
 
 internal Arena platform_init_main_arena(void);
-internal String platform_find_first_file(Arena *arena, StringList *path_list, String file);
+internal void platform_path_builder_set(PathBuilder *builder, String path);
+internal void platform_path_builder_push(PathBuilder *builder, String element);
+internal void platform_path_builder_truncate(PathBuilder *builder, usize len);
+internal String platform_path_find_upwards(String start, String marker, PathKind kind);
+internal PathProbe platform_path_probe_init(Arena *arena, StringArray *dirs);
+internal String platform_file_read_entire(Arena *arena, String path);
+internal b32 platform_file_write_atomic(Arena *arena, String path, String data);
+internal b32 platform_dir_create_all(Arena *arena, String path);
+internal String platform_file_read_into_string(Arena *arena, File file);
+internal FileStream platform_file_stream_open(Arena *arena, String path, u8 *buf, usize cap);
+internal String platform_file_stream_refill(FileStream *stream, usize consumed);
+internal void platform_file_stream_close(FileStream *stream);
 
 internal usize platform_get_page_size(void);
-internal void *platform_mem_reserve(void *addr, usize size);
+internal void *platform_mem_reserve(void *addr, usize size, u32 flags);
 internal void *platform_mem_commit(void *addr, usize size);
+internal void platform_mem_decommit(void *addr, usize size);
 internal void platform_mem_release(void *addr, usize size);
 
 internal String platform_get_process_filename(Arena *arena);
 internal String platform_get_env(Arena *arena, String var);
 internal void platform_set_env(Arena *arena, String key, String value);
+internal StringList platform_get_env_list(Arena *arena);
 internal File platform_file_open(Arena *arena, String path);
+internal File platform_file_create(Arena *arena, String path);
 internal b32 platform_file_close(File file);
 internal b32 platform_file_exists(Arena *arena, String path);
-internal FileIter *platform_file_iter_begin(Arena *arena, String path, u32 flags);
-internal b32 platform_file_iter_next(Arena *arena, FileIter *iter, FileInfo *info);
+internal b32 platform_dir_exists(Arena *arena, String path);
+internal b32 platform_dir_create(Arena *arena, String path);
+internal b32 platform_file_stat(Arena *arena, String path, FileStat *out);
+internal void platform_file_stat_batch(Arena *arena, FileStatEntry *entries, usize count);
+internal b32 platform_file_rename(Arena *arena, String from, String to);
+internal b32 platform_file_delete(Arena *arena, String path);
+internal FileIter platform_file_iter_begin(Arena *arena, String path, u32 flags);
+internal b32 platform_file_iter_next(FileIter *iter, FileInfo *info);
+internal usize platform_file_iter_next_batch(FileIter *iter, FileInfo *infos, usize cap);
 internal void platform_file_iter_end(FileIter *iter);
-internal String platform_file_read_into_string(Arena *arena, File file);
-internal void platform_file_write_string(File file, String s);
+internal usize platform_file_read(File file, void *buf, usize size);
+internal FileMapping platform_file_map(Arena *arena, String path);
+internal void platform_file_unmap(FileMapping *mapping);
+internal b32 platform_file_write_string(File file, String s);
+internal b32 platform_file_write_strings(File file, String *parts, usize count);
+internal Thread platform_thread_start(Arena *arena, ThreadProc *proc, void *data);
+internal void platform_thread_join(Thread thread);
+internal u32 platform_get_processor_count(void);
+internal u64 platform_get_time_ns(void);
 internal Process platform_process_spawn(Arena *arena, CommandLine *cmd_line);
+internal b32 platform_process_exec(Arena *arena, CommandLine *cmd_line);
 internal b32 platform_process_failed(Process process);
-internal b32 platform_process_await(Process process);
+internal b32 platform_process_await(Process process, i32 *out_exit_code);
 internal u64 platform_get_last_error(void);
 internal String platform_get_error_message(u64 error_code);
 internal String platform_get_current_username(Arena *arena);
 internal String platform_get_home_directory(Arena *arena);
+internal String platform_get_current_directory(Arena *arena);
+internal String platform_get_cache_directory(Arena *arena);
+internal u32 platform_get_process_id(void);
+internal String platform_path_resolve(Arena *arena, String path);
+internal PathKind platform_path_builder_kind(PathBuilder *path);
+internal String platform_path_probe_find(PathProbe *probe, String file);
+internal void platform_path_probe_exclude(PathProbe *probe, String dir);
+internal void platform_path_probe_release(PathProbe *probe);
 
 // NOTE(cya): the main program entry point (called by the platform layer)
-internal void entry_point(Arena *arena, CommandLine *cmd_line);
+internal i32 entry_point(Arena *arena, CommandLine *cmd_line);
@@ -5,8 +5,11 @@ inline usize platform_get_page_size(void)
     return info.dwPageSize;
 }
 
-inline void *platform_mem_reserve(void *addr, usize size)
+inline void *platform_mem_reserve(void *addr, usize size, u32 flags)
 {
+    // NOTE(cya): reserving is never charged to the commit limit here, and
+    // large pages need SeLockMemoryPrivilege
+    (void)flags;
     return VirtualAlloc(addr, size, MEM_RESERVE, PAGE_READWRITE);
 }
 
@@ -15,6 +18,11 @@ inline void *platform_mem_commit(void *addr, usize size)
     return VirtualAlloc(addr, size, MEM_COMMIT, PAGE_READWRITE);
 }
 
+inline void platform_mem_decommit(void *addr, usize size)
+{
+    VirtualFree(addr, size, MEM_DECOMMIT);
+}
+
 inline void platform_mem_release(void *addr, usize size)
 {
     (void)size; // NOTE(cya): windows doesn't use it
@@ -65,45 +73,72 @@ internal inline String16 win32_utf16_from_utf8(Arena *arena, String s)
 
 String platform_get_process_filename(Arena *arena)
 {
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
     usize len;
-    usize buf_size;
     usize buf_len = MAX_PATH;
     u16 *buf;
     for (;;) {
-        buf_size = buf_len * sizeof(*buf);
-        buf = arena_push(arena, buf_size);
+        ArenaTemp attempt = arena_temp_begin(scratch.arena);
+        buf = arena_push_array(scratch.arena, buf_len, u16);
         len = GetModuleFileNameW(NULL, buf, buf_len);
         if (len < buf_len) {
             break;
         }
 
-        arena_pop(arena, buf_size);
+        arena_temp_end(attempt);
         buf_len *= 2;
     }
 
     String16 filename_16 = string16_create(buf, len);
-    return win32_utf8_from_utf16(arena, filename_16);
+    String result = win32_utf8_from_utf16(arena, filename_16);
+    arena_scratch_end(scratch);
+    return result;
 }
 
 String platform_get_env(Arena *arena, String key)
 {
-    String16 key_utf16 = win32_utf16_from_utf8(arena, key);
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    String16 key_utf16 = win32_utf16_from_utf8(scratch.arena, key);
     DWORD var_size_utf16 = GetEnvironmentVariableW(key_utf16.str, NULL, 0);
-    u16 *var_utf16 = arena_push_array(arena, var_size_utf16, u16);
+    u16 *var_utf16 = arena_push_array(scratch.arena, var_size_utf16, u16);
     usize len_utf16 = GetEnvironmentVariableW(
         key_utf16.str,
         var_utf16,
         var_size_utf16
     );
 
-    return win32_utf8_from_utf16(arena, string16_create(var_utf16, len_utf16));
+    String result = win32_utf8_from_utf16(arena, string16_create(var_utf16, len_utf16));
+    arena_scratch_end(scratch);
+    return result;
 }
 
 inline void platform_set_env(Arena *arena, String key, String val)
 {
-    String16 key_utf16 = win32_utf16_from_utf8(arena, key);
-    String16 val_utf16 = win32_utf16_from_utf8(arena, val);
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    String16 key_utf16 = win32_utf16_from_utf8(scratch.arena, key);
+    String16 val_utf16 = win32_utf16_from_utf8(scratch.arena, val);
     SetEnvironmentVariableW(key_utf16.str, val_utf16.str);
+    arena_scratch_end(scratch);
+}
+
+// NOTE(cya): `KEY=VALUE` entries (minus the hidden `=C:=C:\...` ones)
+StringList platform_get_env_list(Arena *arena)
+{
+    StringList result = {0};
+    u16 *block = GetEnvironmentStringsW();
+    if (block == NULL) {
+        return result;
+    }
+
+    for (u16 *env = block; *env != 0; env += wcstring_len(env) + 1) {
+        if (*env != '=') {
+            String entry = win32_utf8_from_utf16(arena, string16_from_wcstring(env));
+            string_list_push_back(arena, &result, entry);
+        }
+    }
+
+    FreeEnvironmentStringsW(block);
+    return result;
 }
 
 internal inline usize win32_file_size(void *handle)
@@ -114,12 +149,13 @@ internal inline usize win32_file_size(void *handle)
 
     DWORD size_lo = 0, size_hi = 0;
     size_lo = GetFileSize(handle, &size_hi);
-    return size_lo == INVALID_FILE_SIZE ? 0 : size_lo | size_hi;
+    return size_lo == INVALID_FILE_SIZE ? 0 : ((usize)size_hi << 32) | size_lo;
 }
 
 File platform_file_open(Arena *arena, String path)
 {
-    String16 path_utf16 = win32_utf16_from_utf8(arena, path);
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    String16 path_utf16 = win32_utf16_from_utf8(scratch.arena, path);
     void *handle = CreateFileW(
         path_utf16.str,
         GENERIC_READ,
@@ -129,6 +165,7 @@ File platform_file_open(Arena *arena, String path)
         FILE_ATTRIBUTE_NORMAL,
         NULL
     );
+    arena_scratch_end(scratch);
 
     return (File){
         .handle = handle,
@@ -136,80 +173,299 @@ File platform_file_open(Arena *arena, String path)
     };
 }
 
+File platform_file_create(Arena *arena, String path)
+{
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    String16 path_utf16 = win32_utf16_from_utf8(scratch.arena, path);
+    void *handle = CreateFileW(
+        path_utf16.str,
+        GENERIC_WRITE,
+        0,
+        NULL,
+        CREATE_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        NULL
+    );
+    arena_scratch_end(scratch);
+
+    return (File){.handle = handle};
+}
+
 b32 platform_file_close(File file)
 {
     return CloseHandle(file.handle);
 }
 
-b32 platform_file_exists(Arena *arena, String path)
+internal inline DWORD win32_path_attributes(Arena *arena, String path)
 {
-    String16 path_16 = win32_utf16_from_utf8(arena, path);
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    String16 path_16 = win32_utf16_from_utf8(scratch.arena, path);
     DWORD attributes = GetFileAttributesW(path_16.str);
-    return attributes != INVALID_FILE_ATTRIBUTES;
+    arena_scratch_end(scratch);
+    return attributes;
 }
 
-FileIter *platform_file_iter_begin(Arena *arena, String path, u32 flags)
+b32 platform_file_exists(Arena *arena, String path)
 {
-    String path_with_wildcard = string_path_append(arena, path, string_lit("*"));
-    String16 path_utf16 = win32_utf16_from_utf8(arena, path_with_wildcard);
-    FileIter *iter = arena_push_array(arena, 1, FileIter);
-    iter->flags = flags;
-    iter->data.handle = FindFirstFileExW(
+    return win32_path_attributes(arena, path) != INVALID_FILE_ATTRIBUTES;
+}
+
+b32 platform_dir_exists(Arena *arena, String path)
+{
+    DWORD attributes = win32_path_attributes(arena, path);
+    return attributes != INVALID_FILE_ATTRIBUTES &&
+        (attributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+}
+
+inline b32 platform_dir_create(Arena *arena, String path)
+{
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    String16 path_16 = win32_utf16_from_utf8(scratch.arena, path);
+    b32 created = CreateDirectoryW(path_16.str, NULL) ||
+        GetLastError() == ERROR_ALREADY_EXISTS;
+    arena_scratch_end(scratch);
+    return created;
+}
+
+b32 platform_file_stat(Arena *arena, String path, FileStat *out)
+{
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    String16 path_16 = win32_utf16_from_utf8(scratch.arena, path);
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    b32 found = GetFileAttributesExW(path_16.str, GetFileExInfoStandard, &data);
+    arena_scratch_end(scratch);
+    if (!found) {
+        return false;
+    }
+
+    // NOTE(cya): FILETIME counts 100ns intervals
+    u64 mtime = ((u64)data.ftLastWriteTime.dwHighDateTime << 32) |
+        data.ftLastWriteTime.dwLowDateTime;
+    *out = (FileStat){
+        .is_dir = (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0,
+        .size = ((u64)data.nFileSizeHigh << 32) | data.nFileSizeLow,
+        .mtime = mtime * 100,
+    };
+    return true;
+}
+
+inline void platform_file_stat_batch(Arena *arena, FileStatEntry *entries, usize count)
+{
+    platform_file_stat_each(arena, entries, count);
+}
+
+inline b32 platform_file_rename(Arena *arena, String from, String to)
+{
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    String16 from_16 = win32_utf16_from_utf8(scratch.arena, from);
+    String16 to_16 = win32_utf16_from_utf8(scratch.arena, to);
+    b32 renamed = MoveFileExW(from_16.str, to_16.str, MOVEFILE_REPLACE_EXISTING);
+    arena_scratch_end(scratch);
+    return renamed;
+}
+
+inline b32 platform_file_delete(Arena *arena, String path)
+{
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    String16 path_16 = win32_utf16_from_utf8(scratch.arena, path);
+    b32 deleted = DeleteFileW(path_16.str);
+    arena_scratch_end(scratch);
+    return deleted;
+}
+
+// NOTE(cya): `arena` is only there to be kept out of, the scratch taken here
+// holds the converted names until platform_file_iter_end
+FileIter platform_file_iter_begin(Arena *arena, String path, u32 flags)
+{
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    FileIter iter = {.flags = flags, .scratch = scratch};
+    String path_with_wildcard = string_path_append(scratch.arena, path, string_lit("*"));
+    String16 path_utf16 = win32_utf16_from_utf8(scratch.arena, path_with_wildcard);
+    iter.data.handle = FindFirstFileExW(
         (WCHAR*)path_utf16.str,
         FindExInfoBasic,
-        &iter->data.find_data,
+        &iter.data.find_data,
         FindExSearchNameMatch,
         0,
         FIND_FIRST_EX_LARGE_FETCH
     );
+    iter.data.names_pos = arena_pos(scratch.arena);
+    iter.is_done = iter.data.handle == INVALID_HANDLE_VALUE;
     return iter;
 }
 
-b32 platform_file_iter_next(Arena *arena, FileIter *iter, FileInfo *info)
+internal b32 win32_file_iter_advance(FileIter *iter, FileInfo *info)
 {
-    if (iter->is_done) {
-        return false;
+    Arena *arena = iter->scratch.arena;
+    while (!iter->is_done) {
+        WIN32_FIND_DATAW *find_data = &iter->data.find_data;
+        String name = win32_utf8_from_utf16(arena, string16_from_wcstring(find_data->cFileName));
+        b32 is_dir = (find_data->dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+
+        // NOTE(cya): advancing overwrites `find_data`, so the name is converted first
+        iter->is_done = !FindNextFileW(iter->data.handle, find_data);
+        if (!platform_file_iter_skips(iter, name, is_dir)) {
+            *info = (FileInfo){.name = name, .is_dir = is_dir};
+            return true;
+        }
     }
 
-    do {
-        WCHAR *name = iter->data.find_data.cFileName;
-        DWORD attributes = iter->data.find_data.dwFileAttributes;
-        b32 is_dir = (attributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
-        b32 skip = ((iter->flags & FILE_ITER_SKIP_DIRS) && is_dir) ||
-            ((iter->flags & FILE_ITER_SKIP_FILES) && !is_dir) ||
-            ((iter->flags & FILE_ITER_SKIP_HIDDEN) && name[0] == '.');
-        if (skip) {
-            continue;
+    return false;
+}
+
+// NOTE(cya): FindNextFileW already fetches in bulk (FIND_FIRST_EX_LARGE_FETCH);
+// the previous batch's names are dropped first
+usize platform_file_iter_next_batch(FileIter *iter, FileInfo *infos, usize cap)
+{
+    arena_pop_to(iter->scratch.arena, iter->data.names_pos);
+
+    usize count = 0;
+    while (count < cap && win32_file_iter_advance(iter, &infos[count])) {
+        count += 1;
+    }
+
+    return count;
+}
+
+inline b32 platform_file_iter_next(FileIter *iter, FileInfo *info)
+{
+    return platform_file_iter_next_batch(iter, info, 1) == 1;
+}
+
+inline void platform_file_iter_end(FileIter *iter)
+{
+    if (iter->data.handle != INVALID_HANDLE_VALUE) {
+        FindClose(iter->data.handle);
+    }
+
+    arena_scratch_end(iter->scratch);
+}
+
+usize platform_file_read(File file, void *buf, usize size)
+{
+    DWORD chunk = (DWORD)min(size, 0x7FFFFFFF);
+    DWORD result = 0;
+    if (!ReadFile(file.handle, buf, chunk, &result, NULL)) {
+        return 0;
+    }
+
+    return result;
+}
+
+FileMapping platform_file_map(Arena *arena, String path)
+{
+    FileMapping mapping = {0};
+    File file = platform_file_open(arena, path);
+    if (!platform_file_is_valid(file)) {
+        return mapping;
+    }
+
+    // NOTE(cya): pipes, devices and small files are read
+    b32 mappable = GetFileType(file.handle) == FILE_TYPE_DISK &&
+        file.size >= PLATFORM_FILE_MAP_MIN_SIZE;
+    if (mappable) {
+        HANDLE section = CreateFileMappingW(file.handle, NULL, PAGE_READONLY, 0, 0, NULL);
+        void *data = section == NULL ? NULL : MapViewOfFile(section, FILE_MAP_READ, 0, 0, 0);
+        if (section != NULL) {
+            CloseHandle(section);
         }
 
-        if (!FindNextFileW(iter->data.handle, &iter->data.find_data)) {
-            iter->is_done = true;
+        if (data != NULL) {
+            mapping = (FileMapping){.data = string_create(data, file.size), .is_mapped = true};
         }
+    }
 
-        info->name = win32_utf8_from_utf16(arena, string16_from_wcstring(name));
-        return true;
-    } while (FindNextFileW(iter->data.handle, &iter->data.find_data));
+    if (!mapping.is_mapped) {
+        mapping.data = platform_file_read_into_string(arena, file);
+    }
 
-    iter->is_done = true;
-    return false;
+    platform_file_close(file);
+    return mapping;
 }
 
-inline void platform_file_iter_end(FileIter *iter)
+inline void platform_file_unmap(FileMapping *mapping)
+{
+    if (mapping->is_mapped) {
+        UnmapViewOfFile(mapping->data.str);
+    }
+
+    *mapping = (FileMapping){0};
+}
+
+b32 platform_file_write_string(File file, String s)
+{
+    usize written = 0;
+    while (written < s.len) {
+        DWORD chunk = (DWORD)min(s.len - written, 0x7FFFFFFF);
+        DWORD result = 0;
+        if (!WriteFile(file.handle, &s.str[written], chunk, &result, NULL)) {
+            return false;
+        }
+
+        written += result;
+    }
+
+    return true;
+}
+
+// NOTE(cya): WriteFileGather only takes page-sized unbuffered chunks, so the
+// parts go out one at a time
+b32 platform_file_write_strings(File file, String *parts, usize count)
+{
+    for (usize i = 0; i < count; i++) {
+        if (!platform_file_write_string(file, parts[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+typedef struct {
+    ThreadProc *proc;
+    void *data;
+} Win32ThreadStart;
+
+internal DWORD WINAPI win32_thread_entry(void *param)
+{
+    Win32ThreadStart *start = param;
+    start->proc(start->data);
+    arena_scratch_release();
+    return 0;
+}
+
+Thread platform_thread_start(Arena *arena, ThreadProc *proc, void *data)
+{
+    Win32ThreadStart *start = arena_push_array(arena, 1, Win32ThreadStart);
+    *start = (Win32ThreadStart){.proc = proc, .data = data};
+    return (Thread){.handle = CreateThread(NULL, 0, win32_thread_entry, start, 0, NULL)};
+}
+
+inline void platform_thread_join(Thread thread)
 {
-    FindClose(iter->data.handle);
+    if (thread.handle != NULL) {
+        WaitForSingleObject(thread.handle, INFINITE);
+        CloseHandle(thread.handle);
+    }
 }
 
-inline String platform_file_read_into_string(Arena *arena, File file)
+inline u32 platform_get_processor_count(void)
 {
-    usize size = file.size;
-    u8 *buf = arena_push(arena, size);
-    ReadFile(file.handle, buf, (DWORD)size, NULL, NULL);
-    return string_create(buf, size);
+    SYSTEM_INFO info = {0};
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors < 1 ? 1 : (u32)info.dwNumberOfProcessors;
 }
 
-inline void platform_file_write_string(File file, String s)
+// NOTE(cya): monotonic, only meaningful as a difference; split so the
+// multiply can't overflow for long uptimes
+inline u64 platform_get_time_ns(void)
 {
-    WriteFile(file.handle, s.str, (DWORD)s.len, NULL, NULL);
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    u64 ticks = (u64)counter.QuadPart;
+    u64 rate = (u64)frequency.QuadPart;
+    return ticks / rate * 1000000000ull + ticks % rate * 1000000000ull / rate;
 }
 
 inline Process platform_process_spawn(Arena *arena, CommandLine *cmd_line)
@@ -240,21 +496,49 @@ inline Process platform_process_spawn(Arena *arena, CommandLine *cmd_line)
         &startup_info,
         &process_info
     );
+    if (process_info.hThread != NULL) {
+        CloseHandle(process_info.hThread);
+    }
+
     return (Process){.handle = process_info.hProcess};
 }
 
 inline b32 platform_process_failed(Process process)
 {
-    return process.handle == INVALID_HANDLE_VALUE;
+    return process.handle == NULL || process.handle == INVALID_HANDLE_VALUE;
 }
 
-inline b32 platform_process_await(Process process)
+inline b32 platform_process_await(Process process, i32 *out_exit_code)
 {
     if (platform_process_failed(process)) {
         return false;
     }
 
-    return WaitForSingleObject(process.handle, INFINITE) != WAIT_FAILED;
+    if (WaitForSingleObject(process.handle, INFINITE) == WAIT_FAILED) {
+        return false;
+    }
+
+    DWORD exit_code = 0;
+    b32 success = GetExitCodeProcess(process.handle, &exit_code);
+    CloseHandle(process.handle);
+    if (out_exit_code != NULL) {
+        *out_exit_code = (i32)exit_code;
+    }
+
+    return success;
+}
+
+inline b32 platform_process_exec(Arena *arena, CommandLine *cmd_line)
+{
+    // NOTE(cya): windows can't replace a process image, so the closest we can
+    // get is waiting on the child and forwarding its exit code as our own
+    Process process = platform_process_spawn(arena, cmd_line);
+    i32 exit_code;
+    if (!platform_process_await(process, &exit_code)) {
+        return false;
+    }
+
+    ExitProcess((UINT)exit_code);
 }
 
 thread_local u16 __win32_error_buf[4096];
@@ -321,10 +605,157 @@ inline String platform_get_home_directory(Arena *arena)
     return string_lit("");
 }
 
+String platform_get_current_directory(Arena *arena)
+{
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    DWORD len_utf16 = GetCurrentDirectoryW(0, NULL);
+    u16 *buf = arena_push_array(scratch.arena, len_utf16, u16);
+    len_utf16 = GetCurrentDirectoryW(len_utf16, buf);
+    String result = win32_utf8_from_utf16(arena, string16_create(buf, len_utf16));
+    arena_scratch_end(scratch);
+    return result;
+}
+
+String platform_get_cache_directory(Arena *arena)
+{
+    return platform_get_env(arena, string_lit("LOCALAPPDATA"));
+}
+
+inline u32 platform_get_process_id(void)
+{
+    return (u32)GetCurrentProcessId();
+}
+
+// NOTE(cya): only normalizes the path (symlinks and junctions are kept as-is)
+String platform_path_resolve(Arena *arena, String path)
+{
+    ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+    String16 path_utf16 = win32_utf16_from_utf8(scratch.arena, path);
+    String result = string_lit("");
+    DWORD len_utf16 = GetFullPathNameW(path_utf16.str, 0, NULL, NULL);
+    if (len_utf16 != 0) {
+        u16 *buf = arena_push_array(scratch.arena, len_utf16, u16);
+        len_utf16 = GetFullPathNameW(path_utf16.str, len_utf16, buf, NULL);
+        result = win32_utf8_from_utf16(arena, string16_create(buf, len_utf16));
+    }
+
+    arena_scratch_end(scratch);
+    return result;
+}
+
+internal DWORD win32_path_builder_attributes(PathBuilder *path)
+{
+    // NOTE(cya): UTF-16 never takes more units than UTF-8 takes bytes
+    u16 path_16[PLATFORM_PATH_MAX];
+    usize len = win32_multi_byte_to_wide_char(
+        path->buf,
+        path->len + 1,
+        path_16,
+        array_len(path_16)
+    );
+    return len == 0 ? INVALID_FILE_ATTRIBUTES : GetFileAttributesW(path_16);
+}
+
+inline PathKind platform_path_builder_kind(PathBuilder *path)
+{
+    DWORD attributes = win32_path_builder_attributes(path);
+    if (attributes == INVALID_FILE_ATTRIBUTES) {
+        return PATH_KIND_NONE;
+    }
+
+    return (attributes & FILE_ATTRIBUTE_DIRECTORY) ? PATH_KIND_DIR : PATH_KIND_FILE;
+}
+
+// NOTE(cya): no inodes to go by, so duplicates are only caught when spelled
+// the same (up to case)
+internal b32 win32_path_equals(String a, String b)
+{
+    if (a.len != b.len) {
+        return false;
+    }
+
+    for (usize i = 0; i < a.len; i++) {
+        u8 c_a = a.str[i], c_b = b.str[i];
+        c_a = (c_a >= 'A' && c_a <= 'Z') ? c_a + ('a' - 'A') : c_a;
+        c_b = (c_b >= 'A' && c_b <= 'Z') ? c_b + ('a' - 'A') : c_b;
+        if (c_a != c_b) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+internal void win32_path_probe_open(PathProbe *probe, PathProbeDir *dir)
+{
+    dir->is_opened = true;
+    dir->is_skipped = true;
+
+    PathBuilder path;
+    platform_path_builder_set(&path, dir->path);
+    DWORD attributes = path.overflowed ?
+        INVALID_FILE_ATTRIBUTES : win32_path_builder_attributes(&path);
+    if (attributes == INVALID_FILE_ATTRIBUTES || !(attributes & FILE_ATTRIBUTE_DIRECTORY)) {
+        return;
+    }
+
+    for (PathProbeDir *prev = probe->dirs; prev < dir; prev++) {
+        if (!prev->is_skipped && win32_path_equals(prev->path, dir->path)) {
+            return;
+        }
+    }
+
+    dir->data.attributes = attributes;
+    dir->is_skipped = false;
+}
+
+String platform_path_probe_find(PathProbe *probe, String file)
+{
+    PathBuilder path;
+    for (usize i = 0; i < probe->count; i++) {
+        PathProbeDir *dir = &probe->dirs[i];
+        if (!dir->is_opened) {
+            win32_path_probe_open(probe, dir);
+        }
+
+        if (dir->is_skipped) {
+            continue;
+        }
+
+        platform_path_builder_set(&path, dir->path);
+        platform_path_builder_push(&path, file);
+        DWORD attributes = path.overflowed ?
+            INVALID_FILE_ATTRIBUTES : win32_path_builder_attributes(&path);
+        if (attributes != INVALID_FILE_ATTRIBUTES && !(attributes & FILE_ATTRIBUTE_DIRECTORY)) {
+            return dir->path;
+        }
+    }
+
+    return string_lit("");
+}
+
+void platform_path_probe_exclude(PathProbe *probe, String dir)
+{
+    String path = platform_path_trim_separators(dir);
+    for (usize i = 0; i < probe->count; i++) {
+        if (win32_path_equals(probe->dirs[i].path, path)) {
+            probe->dirs[i].is_opened = true;
+            probe->dirs[i].is_skipped = true;
+        }
+    }
+}
+
+inline void platform_path_probe_release(PathProbe *probe)
+{
+    // NOTE(cya): nothing is held open here
+    (void)probe;
+}
+
 // NOTE(cya): windows's wide entry point for unicode strings
 int wmain(int argc, wchar_t *argv[])
 {
     PLATFORM_PAGE_SIZE = platform_get_page_size();
+    cpu_features_init();
 
     __platform_std_files[STDIN].handle = GetStdHandle(STD_INPUT_HANDLE);
     __platform_std_files[STDOUT].handle = GetStdHandle(STD_OUTPUT_HANDLE);
@@ -342,14 +773,15 @@ int wmain(int argc, wchar_t *argv[])
         string_list_push_back(&arena, &arguments, argument);
     }
 
-    log.arena = &arena;
+    log_init(&arena);
 
     CommandLine cmd_line = command_line_from_string_list(&arguments);
-    entry_point(&arena, &cmd_line);
+    i32 exit_code = entry_point(&arena, &cmd_line);
 
 #if defined(BUILD_DEBUG)
     arena_log_stats(&arena);
 #endif
 
-    return 0;
+    log_flush();
+    return exit_code;
 }
@@ -12,12 +12,23 @@ typedef struct {
     void *handle;
 } Process;
 
+typedef struct {
+    void *handle;
+} Thread;
+
 typedef struct {
     HANDLE handle;
     WIN32_FIND_DATAW find_data;
+    usize names_pos; // NOTE(cya): where each batch's converted names start
 } PlatformFileIter;
 
+typedef struct {
+    DWORD attributes;
+} PlatformPathDir;
+
 #define PLATFORM_PATH_SEPARATOR "\\"
+// NOTE(cya): UTF-8 bytes, comfortably past MAX_PATH (in UTF-16 units)
+#define PLATFORM_PATH_MAX 4096
 #define PLATFORM_LINE_SEPARATOR "\r\n"
 #define PLATFORM_ENV_SEPARATOR ";"
 
@@ -25,8 +36,26 @@ typedef struct {
 #define PLATFORM_SHELL_CMD_FLAG "/C"
 
 #define PLATFORM_MVN_FILE string_lit("mvn.cmd")
+#define PLATFORM_JAVA_FILE string_lit("java.exe")
+#define PLATFORM_JDK_SYSTEM_DIRS { \
+    "C:\\Program Files\\Java", \
+    "C:\\Program Files\\Eclipse Adoptium", \
+    "C:\\Program Files\\Amazon Corretto", \
+    "C:\\Program Files\\Zulu", \
+    "C:\\Program Files\\Microsoft", \
+}
+// NOTE(cya): what mvn.cmd calls unless MAVEN_SKIP_RC is set, the user ones
+// relative to the home directory
+#define PLATFORM_MAVEN_RC_FILES {"C:\\ProgramData\\mavenrc.cmd"}
+#define PLATFORM_MAVEN_USER_RC_FILES { \
+    "mavenrc_pre.bat", \
+    "mavenrc_pre.cmd", \
+    "mavenrc_post.bat", \
+    "mavenrc_post.cmd", \
+}
 
 #define platform_mem_equal(a, b, len) RtlEqualMemory(a, b, len)
 #define platform_mem_copy(d, s, len) RtlCopyMemory(d, s, len)
+#define platform_mem_move(d, s, len) RtlMoveMemory(d, s, len)
 
-#define platform_file_is_valid(f) ((f).handle != NULL)
+#define platform_file_is_valid(f) ((f).handle != NULL && (f).handle != INVALID_HANDLE_VALUE)
@@ -0,0 +1,36 @@
+inline void test_begin(Arena *arena)
+{
+    test_state = (TestState){.arena = arena};
+}
+
+inline b32 test_pass(void)
+{
+    test_state.checks += 1;
+    return true;
+}
+
+b32 test_fail(const char *fmt, ...)
+{
+    test_state.checks += 1;
+    test_state.failures += 1;
+
+    va_list va;
+    va_start(va, fmt);
+    String message = string_fmt_va(test_state.arena, fmt, va);
+    va_end(va);
+
+    File out = platform_get_std_file(STDERR);
+    platform_file_write_string(out, string_lit("FAIL "));
+    platform_file_write_string(out, message);
+    platform_file_write_string(out, string_lit("\n"));
+    return false;
+}
+
+// NOTE(cya): prints the summary and returns the exit code
+i32 test_end(const char *name)
+{
+    const char *fmt = "{}: {u} checks, {u} failed\n";
+    String summary = string_fmt(test_state.arena, fmt, string_from_cstring(name), test_state.checks, test_state.failures);
+    platform_file_write_string(platform_get_std_file(STDOUT), summary);
+    return test_state.failures == 0 ? 0 : 1;
+}
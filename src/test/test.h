@@ -0,0 +1,17 @@
+// NOTE(cya): shared by the programs in this directory, each a unity build
+// like mvn.c that runs its checks and exits non-zero if any of them failed
+typedef struct {
+    Arena *arena; // NOTE(cya): failure messages are formatted here
+    u64 checks;
+    u64 failures;
+} TestState;
+
+global TestState test_state;
+
+// NOTE(cya): the message arguments are only evaluated when the check fails
+#define test_check(cond, ...) ((cond) ? test_pass() : test_fail(__VA_ARGS__))
+
+internal void test_begin(Arena *arena);
+internal b32 test_pass(void);
+internal b32 test_fail(const char *fmt, ...);
+internal i32 test_end(const char *name);
@@ -0,0 +1,60 @@
+#include "../base/base.h"
+#include "../platform/platform.h"
+#include "test.h"
+
+#include "../base/base.c"
+#include "../platform/platform.c"
+#include "test.c"
+
+readonly force_keep char PROGRAM_NAME[] = "test_arena";
+
+#define TEST_POOL_CHUNK_SIZE kibibytes(64)
+#define TEST_ROUNDS 1000
+
+// NOTE(cya): a child that keeps pushing and popping has to settle on the
+// chunks it claimed in the first round, whatever it pops back to
+internal void test_pool_child_reuse(void)
+{
+    ArenaPool pool = arena_pool_init(mebibytes(64), TEST_POOL_CHUNK_SIZE, 0);
+    Arena child = arena_pool_child(&pool);
+
+    // NOTE(cya): popping to 0 hands back every block, the first one included
+    for (usize round = 0; round < TEST_ROUNDS; round++) {
+        u8 *bytes = arena_push(&child, kibibytes(16));
+        test_check(bytes != NULL, "push after popping to 0");
+        bytes[0] = (u8)round;
+        arena_pop_to(&child, 0);
+    }
+
+    test_check(pool.next == TEST_POOL_CHUNK_SIZE, "popping to 0 reuses the first chunk");
+
+    // NOTE(cya): spans a few blocks each round, and the last one is bigger
+    // than a chunk
+    test_check(arena_push(&child, 64) != NULL, "push into a fresh child");
+    usize mark = arena_pos(&child);
+    u64 claimed = 0;
+    for (usize round = 0; round < TEST_ROUNDS; round++) {
+        for (usize i = 0; i < 4; i++) {
+            test_check(arena_push(&child, kibibytes(40)) != NULL, "push across blocks");
+        }
+
+        test_check(arena_push(&child, 2 * TEST_POOL_CHUNK_SIZE) != NULL, "push bigger than a chunk");
+        arena_pop_to(&child, mark);
+        if (round == 0) {
+            claimed = pool.next;
+        }
+    }
+
+    test_check(pool.next == claimed, "popping blocks reuses their chunks");
+    test_check(arena_pos(&child) == mark, "pop restores the position");
+    arena_pool_release(&pool);
+}
+
+i32 entry_point(Arena *arena, CommandLine *cmd_line)
+{
+    unused(cmd_line);
+
+    test_begin(arena);
+    test_pool_child_reuse();
+    return test_end("test_arena");
+}
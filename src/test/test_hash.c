@@ -0,0 +1,118 @@
+#include "../base/base.h"
+#include "../platform/platform.h"
+#include "test.h"
+
+#include "../base/base.c"
+#include "../platform/platform.c"
+#include "test.c"
+
+readonly force_keep char PROGRAM_NAME[] = "test_hash";
+
+// NOTE(cya): xxhsum's sanity buffer, so the expected values can be checked
+// against any reference implementation; lengths straddle every size class
+// (0, 1-3, 4-8, 9-16, 17-128, 129-240) and the 1 KiB block of the long path
+#define TEST_BUFFER_SIZE 4133
+
+typedef struct {
+    usize len;
+    u64 seed;
+    u64 hash_64;
+    Hash128 hash_128;
+} HashVector;
+
+readonly global HashVector HASH_VECTORS[] = {
+    {0, 0x0000000000000000ull, 0x2D06800538D394C2ull, {0x6001C324468D497Full, 0x99AA06D3014798D8ull}},
+    {1, 0x0000000000000000ull, 0xC44BDFF4074EECDBull, {0xC44BDFF4074EECDBull, 0xA6CD5E9392000F6Aull}},
+    {3, 0x0000000000000000ull, 0x54247382A8D6B94Dull, {0x54247382A8D6B94Dull, 0x20EFC49FF02422EAull}},
+    {4, 0x0000000000000000ull, 0xE5DC74BC51848A51ull, {0x2E7D8D6876A39FE9ull, 0x970D585AC632BF8Eull}},
+    {8, 0x0000000000000000ull, 0x24CCC9ACAA9F65E4ull, {0x64C69CAB4BB21DC5ull, 0x47A7F080D82BB456ull}},
+    {9, 0x0000000000000000ull, 0x14D5001C15DD3F2Bull, {0xED7CCBC501EB7501ull, 0x564EF6078950D457ull}},
+    {16, 0x0000000000000000ull, 0x981B17D36C7498C9ull, {0x562980258A998629ull, 0xC68C368ECF8A9C05ull}},
+    {17, 0x0000000000000000ull, 0x796F5ACD3A60F862ull, {0xABBC12D11973D7DBull, 0x955FA78643ED3669ull}},
+    {128, 0x0000000000000000ull, 0xFCFF24126754D861ull, {0xEBB15E34A7FB5AB1ull, 0x39992220E045260Aull}},
+    {129, 0x0000000000000000ull, 0x98F1B0A679A2CA29ull, {0x86C9E3BC8F0A3B5Cull, 0x03815FC91F1B30B6ull}},
+    {240, 0x0000000000000000ull, 0x81C3C2B67F568CCFull, {0x5C9AAE94C8EBE5A0ull, 0xAA4202DAA2769DC8ull}},
+    {241, 0x0000000000000000ull, 0xC5A639ECD2030E5Eull, {0xC5A639ECD2030E5Eull, 0x99A80ECF0ECFC647ull}},
+    {1024, 0x0000000000000000ull, 0xDD85C9B5C1109C5Cull, {0xDD85C9B5C1109C5Cull, 0x0D30D24071C64C57ull}},
+    {2048, 0x0000000000000000ull, 0xDD59E2C3A5F038E0ull, {0xDD59E2C3A5F038E0ull, 0xF736557FD47073A5ull}},
+    {2367, 0x0000000000000000ull, 0xCB37AEB9E5D361EDull, {0xCB37AEB9E5D361EDull, 0xE89C0F6FF369B427ull}},
+    {4133, 0x0000000000000000ull, 0xB1793BB4317787F8ull, {0xB1793BB4317787F8ull, 0xD83FA6A792ACB0C0ull}},
+    {0, 0x9E3779B185EBCA8Dull, 0xA8A6B918B2F0364Aull, {0xA986DFC5D7605BFEull, 0x00FEAA732A3CE25Eull}},
+    {1, 0x9E3779B185EBCA8Dull, 0x032BE332DD766EF8ull, {0x032BE332DD766EF8ull, 0x20E49ABCC53B3842ull}},
+    {3, 0x9E3779B185EBCA8Dull, 0x634B8990B4976373ull, {0x634B8990B4976373ull, 0x1C7ECF6A308CF00Eull}},
+    {4, 0x9E3779B185EBCA8Dull, 0xAA2E7ECCB0C8F747ull, {0xBFAF51F1E67E0B0Full, 0x3D53E5DFD837D927ull}},
+    {8, 0x9E3779B185EBCA8Dull, 0x8F973410999B8F6Bull, {0x7B29471DC729B5FFull, 0xF50CEC145BCD5C5Aull}},
+    {9, 0x9E3779B185EBCA8Dull, 0xB3AE7333D9013F60ull, {0xAEF5DFC0AC9F9044ull, 0x6B380B43FFA61042ull}},
+    {16, 0x9E3779B185EBCA8Dull, 0x663F29333B4DB6B1ull, {0x0346D13A7A5498C7ull, 0x6FFCB80CD33085C8ull}},
+    {17, 0x9E3779B185EBCA8Dull, 0xF3EC5067F4306DB3ull, {0x980A14119985A7DFull, 0xD77681219E464828ull}},
+    {128, 0x9E3779B185EBCA8Dull, 0x73FDE75280646649ull, {0x8394F5C51F1D8246ull, 0xA0F7CCB68EE02ADDull}},
+    {129, 0x9E3779B185EBCA8Dull, 0x21FFFDBCA099C844ull, {0xD4AAE26FCEC7DC03ull, 0xAD559266067C0BF3ull}},
+    {240, 0x9E3779B185EBCA8Dull, 0xCC0F58C27EF3D8EEull, {0x604E98DB085C1864ull, 0x29D2133D6EA58C5Bull}},
+    {241, 0x9E3779B185EBCA8Dull, 0xDDA9B0A161D4829Aull, {0xDDA9B0A161D4829Aull, 0xEC64AFAE6A137582ull}},
+    {1024, 0x9E3779B185EBCA8Dull, 0xEF368A8A2EBABAEFull, {0xEF368A8A2EBABAEFull, 0x17600EFE2B493A18ull}},
+    {2048, 0x9E3779B185EBCA8Dull, 0x66F81670669ABABCull, {0x66F81670669ABABCull, 0x23CC3A2E75EBAAEAull}},
+    {2367, 0x9E3779B185EBCA8Dull, 0xD2DB3415B942B42Aull, {0xD2DB3415B942B42Aull, 0xCCB7A94CCA1A6496ull}},
+    {4133, 0x9E3779B185EBCA8Dull, 0x13CDADE8147771D8ull, {0x13CDADE8147771D8ull, 0xB5CB8DE1D75A0D4Cull}},
+};
+
+// NOTE(cya): odd sizes on purpose, so updates cut across stripes, the
+// internal buffer and blocks at every offset
+readonly global usize CHUNK_SIZES[] = {1, 7, 63, 64, 65, 255, 256, 257, 1000, TEST_BUFFER_SIZE};
+
+internal b32 test_hash_128_equal(Hash128 a, Hash128 b)
+{
+    return a.lo == b.lo && a.hi == b.hi;
+}
+
+internal void test_hash_vectors(HashState *state, u8 *buffer)
+{
+    for (usize v = 0; v < array_len(HASH_VECTORS); v++) {
+        HashVector *vector = &HASH_VECTORS[v];
+        String data = string_create(buffer, vector->len);
+        u64 len = vector->len;
+        u64 seed = vector->seed;
+        const char *fmt = "{} len={u} seed={x} chunk={u}";
+        test_check(hash_64(data, seed) == vector->hash_64, fmt, string_lit("hash_64"), len, seed, (u64)0);
+        Hash128 hash = hash_128(data, seed);
+        test_check(test_hash_128_equal(hash, vector->hash_128), fmt, string_lit("hash_128"), len, seed, (u64)0);
+
+        for (usize c = 0; c < array_len(CHUNK_SIZES); c++) {
+            u64 chunk = CHUNK_SIZES[c];
+            hash_state_init(state, seed);
+            for (usize pos = 0; pos < data.len; pos += chunk) {
+                hash_update(state, string_create(&data.str[pos], min(chunk, data.len - pos)));
+            }
+
+            u64 digest_64 = hash_digest_64(state);
+            test_check(digest_64 == vector->hash_64, fmt, string_lit("hash_digest_64"), len, seed, chunk);
+            Hash128 digest_128 = hash_digest_128(state);
+            b32 is_equal = test_hash_128_equal(digest_128, vector->hash_128);
+            test_check(is_equal, fmt, string_lit("hash_digest_128"), len, seed, chunk);
+        }
+    }
+}
+
+i32 entry_point(Arena *arena, CommandLine *cmd_line)
+{
+    unused(cmd_line);
+
+    test_begin(arena);
+    u8 *buffer = arena_push(arena, TEST_BUFFER_SIZE);
+    u64 byte_gen = 2654435761ull;
+    for (usize i = 0; i < TEST_BUFFER_SIZE; i++) {
+        buffer[i] = (u8)(byte_gen >> 56);
+        byte_gen *= 11400714785074694797ull;
+    }
+
+    // NOTE(cya): once more without AVX2, so the SSE2 kernels get checked too
+    HashState *state = arena_push(arena, sizeof(HashState));
+    test_hash_vectors(state, buffer);
+#if defined(ARCH_X64)
+    if (cpu_features.has_avx2) {
+        cpu_features.has_avx2 = false;
+        test_hash_vectors(state, buffer);
+    }
+#endif
+
+    return test_end("test_hash");
+}
@@ -0,0 +1,91 @@
+#include "../base/base.h"
+#include "../platform/platform.h"
+#include "test.h"
+
+#include "../base/base.c"
+#include "../platform/platform.c"
+#include "test.c"
+
+readonly force_keep char PROGRAM_NAME[] = "test_string";
+
+#define TEST_CASES 150000 // NOTE(cya): per kernel set
+#define TEST_HAYSTACK_MAX 300
+
+// NOTE(cya): the definition string_find has to agree with
+internal usize test_find_naive(String haystack, String needle, usize from)
+{
+    if (needle.len == 0) {
+        return min(from, haystack.len);
+    }
+
+    for (usize i = from; i + needle.len <= haystack.len; i++) {
+        if (mem_equal(&haystack.str[i], needle.str, needle.len)) {
+            return i;
+        }
+    }
+
+    return haystack.len;
+}
+
+internal u64 test_random(u64 *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// NOTE(cya): a tiny alphabet so partial matches are everywhere, and needles
+// that are mostly cut from the haystack itself so full ones are too; lengths
+// cross the 16 and 32-byte blocks of both kernels
+internal void test_string_find(u8 *haystack_buf, u8 *needle_buf, u64 seed)
+{
+    u64 state = seed;
+    for (u64 i = 0; i < TEST_CASES; i++) {
+        usize haystack_len = (usize)(test_random(&state) % (TEST_HAYSTACK_MAX + 1));
+        u8 alphabet = (u8)(1 + test_random(&state) % 4);
+        for (usize j = 0; j < haystack_len; j++) {
+            haystack_buf[j] = (u8)('a' + test_random(&state) % alphabet);
+        }
+
+        usize needle_len = (usize)(test_random(&state) % 40);
+        if (haystack_len > needle_len && test_random(&state) % 4 != 0) {
+            usize start = (usize)(test_random(&state) % (haystack_len - needle_len));
+            mem_copy(needle_buf, &haystack_buf[start], needle_len);
+        } else {
+            for (usize j = 0; j < needle_len; j++) {
+                needle_buf[j] = (u8)('a' + test_random(&state) % alphabet);
+            }
+        }
+
+        if (needle_len > 0 && test_random(&state) % 8 == 0) {
+            needle_buf[test_random(&state) % needle_len] = 'z';
+        }
+
+        String haystack = string_create(haystack_buf, haystack_len);
+        String needle = string_create(needle_buf, needle_len);
+        usize from = (usize)(test_random(&state) % (haystack_len + 2));
+        usize expected = test_find_naive(haystack, needle, from);
+        usize found = string_find(haystack, needle, from);
+        test_check(found == expected, "string_find case {u}: found {u}, expected {u}", i, (u64)found, (u64)expected);
+    }
+}
+
+i32 entry_point(Arena *arena, CommandLine *cmd_line)
+{
+    unused(cmd_line);
+
+    test_begin(arena);
+    u8 *haystack_buf = arena_push(arena, TEST_HAYSTACK_MAX);
+    u8 *needle_buf = arena_push(arena, 64);
+    test_string_find(haystack_buf, needle_buf, 0x9E3779B97F4A7C15ull);
+#if defined(ARCH_X64)
+    // NOTE(cya): again on the SSE2 kernel
+    if (cpu_features.has_avx2) {
+        cpu_features.has_avx2 = false;
+        test_string_find(haystack_buf, needle_buf, 0xD1B54A32D192ED03ull);
+    }
+#endif
+
+    return test_end("test_string");
+}
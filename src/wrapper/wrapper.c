@@ -0,0 +1,6 @@
+#include "wrapper_bootstrap.c"
+#include "wrapper_cache.c"
+#include "wrapper_jdk.c"
+#include "wrapper_properties.c"
+#include "wrapper_pom.c"
+#include "wrapper_reactor.c"
@@ -0,0 +1,11 @@
+#ifndef WRAPPER_H
+#define WRAPPER_H
+
+#include "wrapper_bootstrap.h"
+#include "wrapper_cache.h"
+#include "wrapper_jdk.h"
+#include "wrapper_properties.h"
+#include "wrapper_pom.h"
+#include "wrapper_reactor.h"
+
+#endif // WRAPPER_H
@@ -0,0 +1,242 @@
+readonly global char CLASSWORLDS_JAR_PREFIX[] = "plexus-classworlds-";
+readonly global char CLASSWORLDS_LAUNCHER[] = "org.codehaus.plexus.classworlds.launcher.Launcher";
+readonly global char PROJECT_CONFIG_DIR[] = ".mvn";
+
+// NOTE(cya): word splitting the same way the script's unquoted expansions do
+internal void bootstrap_push_words(Arena *arena, StringList *list, String s)
+{
+    usize i = 0;
+    while (i < s.len) {
+        for (; i < s.len && char_is_whitespace(s.str[i]); i++) {}
+
+        usize start = i;
+        for (; i < s.len && !char_is_whitespace(s.str[i]); i++) {}
+
+        if (i > start) {
+            string_list_push_back(arena, list, string_create(&s.str[start], i - start));
+        }
+    }
+}
+
+internal String bootstrap_find_classworlds_jar(Arena *arena, String maven_home)
+{
+    String boot_dir = string_path_append(arena, maven_home, string_lit("boot"));
+    String result = string_lit("");
+    String prefix = string_lit(CLASSWORLDS_JAR_PREFIX);
+    FileInfo info;
+    FileIter iter = platform_file_iter_begin(arena, boot_dir, FILE_ITER_SKIP_DIRS);
+    while (platform_file_iter_next(&iter, &info)) {
+        String name = info.name;
+        if (string_starts_with(name, prefix) && string_ends_with(name, string_lit(".jar"))) {
+            result = string_path_append(arena, boot_dir, name);
+            break;
+        }
+    }
+
+    platform_file_iter_end(&iter);
+    return result;
+}
+
+internal String bootstrap_find_java(Arena *arena, PathProbe *path_probe)
+{
+    String java_home = platform_get_env(arena, string_lit("JAVA_HOME"));
+    if (!string_is_empty(java_home)) {
+        String bin = string_path_append(arena, java_home, string_lit("bin"));
+        String java = string_path_append(arena, bin, PLATFORM_JAVA_FILE);
+        return platform_file_exists(arena, java) ? java : string_lit("");
+    }
+
+    String dir = platform_path_probe_find(path_probe, PLATFORM_JAVA_FILE);
+    return string_is_empty(dir) ? dir : string_path_append(arena, dir, PLATFORM_JAVA_FILE);
+}
+
+// NOTE(cya): the script starts at the `-f`/`--file` argument's directory (or
+// the cwd) and walks up looking for `.mvn`, falling back to where it started
+internal String bootstrap_find_project_dir(Arena *arena, StringList *arguments)
+{
+    String start = platform_get_current_directory(arena);
+    b32 is_file_arg = false;
+    string_list_foreach(arguments, node) {
+        String argument = node->str;
+        if (is_file_arg) {
+            String file = platform_path_resolve(arena, argument);
+            if (!string_is_empty(file)) {
+                start = platform_dir_exists(arena, file) ?
+                    file : string_path_pop_element(file);
+            }
+
+            break;
+        }
+
+        is_file_arg = string_equals(argument, string_lit("-f")) ||
+            string_equals(argument, string_lit("--file"));
+    }
+
+    String marker = string_lit(PROJECT_CONFIG_DIR);
+    String dir = platform_path_find_upwards(start, marker, PATH_KIND_DIR);
+    return string_is_empty(dir) ? start : dir;
+}
+
+// NOTE(cya): rc files are shell (or batch) scripts that can change JAVA_HOME,
+// MAVEN_OPTS or anything else, only the script itself can run them
+internal String bootstrap_find_rc_file(Arena *arena)
+{
+    if (!string_is_empty(platform_get_env(arena, string_lit("MAVEN_SKIP_RC")))) {
+        return string_lit("");
+    }
+
+    const char *system_files[] = PLATFORM_MAVEN_RC_FILES;
+    for (usize i = 0; i < array_len(system_files); i++) {
+        String path = string_from_cstring(system_files[i]);
+        if (platform_file_exists(arena, path)) {
+            return path;
+        }
+    }
+
+    String home = platform_get_home_directory(arena);
+    const char *user_files[] = PLATFORM_MAVEN_USER_RC_FILES;
+    for (usize i = 0; i < array_len(user_files) && !string_is_empty(home); i++) {
+        String path = string_path_append(arena, home, string_from_cstring(user_files[i]));
+        if (platform_file_exists(arena, path)) {
+            return path;
+        }
+    }
+
+    return string_lit("");
+}
+
+b32 bootstrap_resolve(
+    Arena *arena,
+    String mvn_launcher,
+    PathProbe *path_probe,
+    StringList *arguments,
+    MavenBootstrap *out
+) {
+    String rc_file = bootstrap_find_rc_file(arena);
+    if (!string_is_empty(rc_file)) {
+        log_debug("maven rc file found @ {}, leaving it to the script", rc_file);
+        return false;
+    }
+
+    // NOTE(cya): launchers on PATH are usually symlinks into the real install
+    String launcher = platform_path_resolve(arena, mvn_launcher);
+    String maven_home = string_path_pop_element(string_path_pop_element(launcher));
+    if (string_is_empty(maven_home)) {
+        log_debug("unable to resolve maven home from {}", mvn_launcher);
+        return false;
+    }
+
+    String jar = bootstrap_find_classworlds_jar(arena, maven_home);
+    if (string_is_empty(jar)) {
+        log_debug("no classworlds jar found @ {}", maven_home);
+        return false;
+    }
+
+    String bin = string_path_append(arena, maven_home, string_lit("bin"));
+    String conf = string_path_append(arena, bin, string_lit("m2.conf"));
+    if (!platform_file_exists(arena, conf)) {
+        log_debug("no classworlds config found @ {}", conf);
+        return false;
+    }
+
+    String java = bootstrap_find_java(arena, path_probe);
+    if (string_is_empty(java)) {
+        log_debug("no java executable found (check your PATH or JAVA_HOME)");
+        return false;
+    }
+
+    *out = (MavenBootstrap){
+        .maven_home = maven_home,
+        .project_dir = bootstrap_find_project_dir(arena, arguments),
+        .java_exe = java,
+        .classworlds_jar = jar,
+        .classworlds_conf = conf,
+    };
+    return true;
+}
+
+// NOTE(cya): comments and CRs are stripped and `${MAVEN_PROJECTBASEDIR}`
+// expanded, same as the script's `sed` pipeline
+internal void bootstrap_push_jvm_config(Arena *arena, StringList *list, String project_dir)
+{
+    String config_name = string_lit(PROJECT_CONFIG_DIR);
+    String config_dir = string_path_append(arena, project_dir, config_name);
+    String path = string_path_append(arena, config_dir, string_lit("jvm.config"));
+    String config = platform_file_read_entire(arena, path);
+
+    String variable = string_lit("${MAVEN_PROJECTBASEDIR}");
+    StringList words = {0};
+    StringLineIter lines = string_line_iter(config);
+    String line;
+    while (string_line_next(&lines, &line)) {
+        for (usize j = 0; j < line.len; j++) {
+            if (line.str[j] == '#') {
+                line.len = j;
+                break;
+            }
+        }
+
+        bootstrap_push_words(arena, &words, line);
+    }
+
+    string_list_foreach(&words, node) {
+        String word = node->str;
+        usize i = string_find(word, variable, 0);
+        if (i == word.len) {
+            string_list_push_back(arena, list, word);
+            continue;
+        }
+
+        // NOTE(cya): sed's `g`, every occurrence in the word is replaced
+        StringList parts = {0};
+        for (; i < word.len; i = string_find(word, variable, 0)) {
+            string_list_push_back(arena, &parts, string_create(word.str, i));
+            string_list_push_back(arena, &parts, project_dir);
+            word = string_cut_leading(word, i + variable.len);
+        }
+
+        string_list_push_back(arena, &parts, word);
+        string_list_push_back(arena, list, string_list_join(arena, &parts, string_lit("")));
+    }
+}
+
+CommandLine bootstrap_command_line(Arena *arena, MavenBootstrap *bootstrap, StringList *arguments)
+{
+    StringList *args = arena_push_array(arena, 1, StringList);
+    *args = (StringList){0};
+
+    bootstrap_push_jvm_config(arena, args, bootstrap->project_dir);
+
+    String maven_opts = platform_get_env(arena, string_lit("MAVEN_OPTS"));
+    bootstrap_push_words(arena, args, maven_opts);
+
+    String maven_home = bootstrap->maven_home;
+    String lib = string_path_append(arena, maven_home, string_lit("lib"));
+    String jansi = string_path_append(arena, lib, string_lit("jansi-native"));
+    String conf = bootstrap->classworlds_conf;
+    String project_dir = bootstrap->project_dir;
+    string_list_push_back(arena, args, string_lit("-classpath"));
+    string_list_push_back(arena, args, bootstrap->classworlds_jar);
+    string_list_push_back(arena, args, string_fmt(arena, "-Dclassworlds.conf={}", conf));
+    string_list_push_back(arena, args, string_fmt(arena, "-Dmaven.home={}", maven_home));
+    string_list_push_back(arena, args, string_fmt(arena, "-Dlibrary.jansi.path={}", jansi));
+    string_list_push_back(
+        arena,
+        args,
+        string_fmt(arena, "-Dmaven.multiModuleProjectDirectory={}", project_dir)
+    );
+    string_list_push_back(arena, args, string_lit(CLASSWORLDS_LAUNCHER));
+
+    // NOTE(cya): maven 3.9's script puts these ahead of the user's arguments
+    String maven_args = platform_get_env(arena, string_lit("MAVEN_ARGS"));
+    bootstrap_push_words(arena, args, maven_args);
+
+    string_list_foreach(arguments, node) {
+        string_list_push_back(arena, args, node->str);
+    }
+
+    return (CommandLine){
+        .exe_name = bootstrap->java_exe,
+        .arguments = args,
+    };
+}
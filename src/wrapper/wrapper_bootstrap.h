@@ -0,0 +1,21 @@
+// NOTE(cya): everything the `mvn` launcher script would have figured out
+typedef struct {
+    String maven_home;
+    String project_dir;
+    String java_exe;
+    String classworlds_jar;
+    String classworlds_conf;
+} MavenBootstrap;
+
+internal b32 bootstrap_resolve(
+    Arena *arena,
+    String mvn_launcher,
+    PathProbe *path_probe,
+    StringList *arguments,
+    MavenBootstrap *out
+);
+internal CommandLine bootstrap_command_line(
+    Arena *arena,
+    MavenBootstrap *bootstrap,
+    StringList *arguments
+);
@@ -0,0 +1,326 @@
+readonly global char CACHE_DIR_NAME[] = "mvn_wrapper";
+readonly global u32 CACHE_MAGIC = 0x574E564D; // NOTE(cya): "MVNW"
+readonly global u32 CACHE_FORMAT_VERSION = 6;
+
+BlobWriter blob_writer_init(Arena *arena, usize cap)
+{
+    return (BlobWriter){
+        .buf = arena_push(arena, cap),
+        .cap = cap,
+    };
+}
+
+internal inline void blob_write(BlobWriter *writer, const void *data, usize len)
+{
+    if (writer->overflowed || writer->len + len > writer->cap) {
+        writer->overflowed = true;
+        return;
+    }
+
+    mem_copy(&writer->buf[writer->len], data, len);
+    writer->len += len;
+}
+
+// NOTE(cya): native byte order, these files never leave the machine
+inline void blob_write_u32(BlobWriter *writer, u32 value)
+{
+    blob_write(writer, &value, sizeof(value));
+}
+
+inline void blob_write_u64(BlobWriter *writer, u64 value)
+{
+    blob_write(writer, &value, sizeof(value));
+}
+
+inline void blob_write_string(BlobWriter *writer, String s)
+{
+    blob_write_u32(writer, (u32)s.len);
+    blob_write(writer, s.str, s.len);
+}
+
+inline String blob_writer_result(BlobWriter *writer)
+{
+    return writer->overflowed ? string_lit("") : string_create(writer->buf, writer->len);
+}
+
+inline BlobReader blob_reader_init(String data)
+{
+    return (BlobReader){.data = data};
+}
+
+internal inline u8 *blob_read(BlobReader *reader, usize len)
+{
+    if (reader->failed || reader->pos + len > reader->data.len) {
+        reader->failed = true;
+        return NULL;
+    }
+
+    u8 *result = &reader->data.str[reader->pos];
+    reader->pos += len;
+    return result;
+}
+
+inline u32 blob_read_u32(BlobReader *reader)
+{
+    u32 value = 0;
+    u8 *data = blob_read(reader, sizeof(value));
+    if (data != NULL) {
+        mem_copy(&value, data, sizeof(value));
+    }
+
+    return value;
+}
+
+inline u64 blob_read_u64(BlobReader *reader)
+{
+    u64 value = 0;
+    u8 *data = blob_read(reader, sizeof(value));
+    if (data != NULL) {
+        mem_copy(&value, data, sizeof(value));
+    }
+
+    return value;
+}
+
+inline String blob_read_string(BlobReader *reader)
+{
+    u32 len = blob_read_u32(reader);
+    u8 *data = blob_read(reader, len);
+    return data == NULL ? string_lit("") : string_create(data, len);
+}
+
+// NOTE(cya): length-prefixed so ("ab", "c") and ("a", "bc") differ
+inline void cache_hash_string(HashState *state, String s)
+{
+    hash_update_u64(state, s.len);
+    hash_update(state, s);
+}
+
+String cache_file_path(Arena *arena, String name, u64 hash, String extension)
+{
+    String cache_home = platform_get_cache_directory(arena);
+    if (string_is_empty(cache_home)) {
+        return cache_home;
+    }
+
+    String dir = string_path_append(arena, cache_home, string_lit(CACHE_DIR_NAME));
+    String file_name = string_fmt(arena, "{}-{x}{}", name, hash, extension);
+    return string_path_append(arena, dir, file_name);
+}
+
+internal inline u64 cache_stamp_entry(FileStatEntry *entry)
+{
+    FileStat stat = entry->exists ? entry->stat : (FileStat){0};
+    u64 fields[] = {entry->exists, stat.size, stat.mtime};
+    return hash_64(string_create(fields, sizeof(fields)), 0);
+}
+
+internal inline u64 cache_stamp(Arena *arena, String path)
+{
+    FileStatEntry entry = {.path = path};
+    entry.exists = platform_file_stat(arena, path, &entry.stat);
+    return cache_stamp_entry(&entry);
+}
+
+// NOTE(cya): in list order; stat'ed as one batch, which is where most of a
+// warm run's syscalls go for large reactors
+internal u64 *cache_stamp_list(Arena *arena, StringList *paths)
+{
+    usize count = paths->node_count;
+    FileStatEntry *entries = arena_push_array(arena, count, FileStatEntry);
+    usize i = 0;
+    string_list_foreach(paths, node) {
+        entries[i++] = (FileStatEntry){.path = node->str};
+    }
+
+    platform_file_stat_batch(arena, entries, count);
+
+    u64 *stamps = arena_push_array(arena, count, u64);
+    for (i = 0; i < count; i++) {
+        stamps[i] = cache_stamp_entry(&entries[i]);
+    }
+
+    return stamps;
+}
+
+// NOTE(cya): changes whenever any of the paths' stamps does
+u64 cache_stamp_combined(Arena *arena, StringList *paths)
+{
+    u64 *stamps = cache_stamp_list(arena, paths);
+    return hash_64(string_create(stamps, paths->node_count * sizeof(*stamps)), 0);
+}
+
+inline usize cache_env_inputs_size(StringList *names)
+{
+    return sizeof(u32) + names->total_len + names->node_count * (sizeof(u32) + sizeof(u64));
+}
+
+// NOTE(cya): `${env.*}` values come from the live environment and have no
+// stamp, so each name is stored with a hash of the value it had
+void cache_write_env_inputs(Arena *arena, BlobWriter *writer, StringList *names)
+{
+    HashMap seen = hash_map_init(arena, names->node_count);
+    StringList unique = {0};
+    string_list_foreach(names, node) {
+        if (hash_map_insert(&seen, node->str, 0)) {
+            string_list_push_back(arena, &unique, node->str);
+        }
+    }
+
+    blob_write_u32(writer, (u32)unique.node_count);
+    string_list_foreach(&unique, node) {
+        blob_write_string(writer, node->str);
+        blob_write_u64(writer, hash_64(platform_get_env(arena, node->str), 0));
+    }
+}
+
+// NOTE(cya): fails as soon as one of the variables has a different value now
+b32 cache_read_env_inputs(Arena *arena, BlobReader *reader, StringList *out_names)
+{
+    u32 count = blob_read_u32(reader);
+    if (reader->failed || count > reader->data.len / (sizeof(u32) + sizeof(u64))) {
+        return false;
+    }
+
+    for (u32 i = 0; i < count; i++) {
+        String name = blob_read_string(reader);
+        u64 value_hash = blob_read_u64(reader);
+        if (reader->failed || hash_64(platform_get_env(arena, name), 0) != value_hash) {
+            return false;
+        }
+
+        string_list_push_back(arena, out_names, name);
+    }
+
+    return true;
+}
+
+// NOTE(cya): only in-memory values go in here, anything that needs a stat is
+// an input and only checked once a stored entry matched the key
+CacheKey cache_key_create(String project_dir, StringList *env_values)
+{
+    HashState state;
+    hash_state_init(&state, 0);
+    string_list_foreach(env_values, node) {
+        cache_hash_string(&state, node->str);
+    }
+
+    return (CacheKey){
+        .project_dir = project_dir,
+        .project_hash = hash_64(project_dir, 0),
+        .fingerprint = hash_digest_64(&state),
+    };
+}
+
+internal inline String cache_resolution_path(Arena *arena, CacheKey *key)
+{
+    String name = string_lit("resolution");
+    return cache_file_path(arena, name, key->project_hash, string_lit(".bin"));
+}
+
+internal b32 cache_read(Arena *arena, String data, CacheKey *key, Resolution *out)
+{
+    BlobReader reader = blob_reader_init(data);
+    b32 valid = blob_read_u32(&reader) == CACHE_MAGIC &&
+        blob_read_u32(&reader) == CACHE_FORMAT_VERSION &&
+        blob_read_u64(&reader) == key->fingerprint;
+    String project_dir = blob_read_string(&reader);
+    if (!valid || !string_equals(project_dir, key->project_dir)) {
+        return false;
+    }
+
+    Resolution resolution = {
+        .mvn_path = blob_read_string(&reader),
+        .version = blob_read_string(&reader),
+        .pom_file = blob_read_string(&reader),
+        .jdk_path = blob_read_string(&reader),
+        .maven_opts = blob_read_string(&reader),
+    };
+
+    if (!cache_read_env_inputs(arena, &reader, &resolution.env_inputs)) {
+        return false;
+    }
+
+    // NOTE(cya): inputs are only known after resolving, so they carry their
+    // own stamps; each record takes at least 12 bytes, which bounds the count
+    u32 input_count = blob_read_u32(&reader);
+    if (reader.failed || input_count > data.len / (sizeof(u32) + sizeof(u64))) {
+        return false;
+    }
+
+    u64 *stored = arena_push_array(arena, input_count, u64);
+    for (u32 i = 0; i < input_count && !reader.failed; i++) {
+        string_list_push_back(arena, &resolution.inputs, blob_read_string(&reader));
+        stored[i] = blob_read_u64(&reader);
+    }
+
+    if (reader.failed) {
+        return false;
+    }
+
+    u64 *stamps = cache_stamp_list(arena, &resolution.inputs);
+    for (u32 i = 0; i < input_count; i++) {
+        if (stamps[i] != stored[i]) {
+            return false;
+        }
+    }
+
+    *out = resolution;
+    return true;
+}
+
+// NOTE(cya): the loaded strings point into the mapping, which stays around
+b32 cache_load(Arena *arena, CacheKey *key, Resolution *out)
+{
+    String path = cache_resolution_path(arena, key);
+    FileMapping mapping = platform_file_map(arena, path);
+    if (string_is_empty(mapping.data)) {
+        return false;
+    }
+
+    if (!cache_read(arena, mapping.data, key, out)) {
+        platform_file_unmap(&mapping);
+        return false;
+    }
+
+    return true;
+}
+
+b32 cache_store(Arena *arena, CacheKey *key, Resolution *resolution)
+{
+    String path = cache_resolution_path(arena, key);
+    if (string_is_empty(path)) {
+        return false;
+    }
+
+    usize size = kibibytes(4) + resolution->inputs.total_len +
+        resolution->inputs.node_count * (sizeof(u32) + sizeof(u64)) +
+        cache_env_inputs_size(&resolution->env_inputs);
+    BlobWriter writer = blob_writer_init(arena, size);
+    blob_write_u32(&writer, CACHE_MAGIC);
+    blob_write_u32(&writer, CACHE_FORMAT_VERSION);
+    blob_write_u64(&writer, key->fingerprint);
+    blob_write_string(&writer, key->project_dir);
+    blob_write_string(&writer, resolution->mvn_path);
+    blob_write_string(&writer, resolution->version);
+    blob_write_string(&writer, resolution->pom_file);
+    blob_write_string(&writer, resolution->jdk_path);
+    blob_write_string(&writer, resolution->maven_opts);
+    cache_write_env_inputs(arena, &writer, &resolution->env_inputs);
+
+    blob_write_u32(&writer, (u32)resolution->inputs.node_count);
+    u64 *stamps = cache_stamp_list(arena, &resolution->inputs);
+    usize i = 0;
+    string_list_foreach(&resolution->inputs, node) {
+        blob_write_string(&writer, node->str);
+        blob_write_u64(&writer, stamps[i++]);
+    }
+
+    String data = blob_writer_result(&writer);
+    if (string_is_empty(data)) {
+        return false;
+    }
+
+    return platform_dir_create_all(arena, string_path_pop_element(path)) &&
+        platform_file_write_atomic(arena, path, data);
+}
@@ -0,0 +1,54 @@
+// NOTE(cya): append-only binary blobs; strings read back are views into the
+// blob itself, so a loaded (or mapped) file is used in place
+typedef struct {
+    u8 *buf;
+    usize cap;
+    usize len;
+    b32 overflowed;
+} BlobWriter;
+
+typedef struct {
+    String data;
+    usize pos;
+    b32 failed;
+} BlobReader;
+
+// NOTE(cya): what discovery produced, i.e. what warm runs get to skip
+typedef struct {
+    String mvn_path;
+    String version;
+    String pom_file;
+    String jdk_path;
+    String maven_opts;
+    StringList inputs; // NOTE(cya): files read along the way (parent poms, ...)
+    StringList env_inputs; // NOTE(cya): variables read through `${env.*}`
+} Resolution;
+
+typedef struct {
+    String project_dir;
+    u64 project_hash;
+    u64 fingerprint;
+} CacheKey;
+
+internal BlobWriter blob_writer_init(Arena *arena, usize cap);
+internal void blob_write_u32(BlobWriter *writer, u32 value);
+internal void blob_write_u64(BlobWriter *writer, u64 value);
+internal void blob_write_string(BlobWriter *writer, String s);
+internal String blob_writer_result(BlobWriter *writer);
+
+internal BlobReader blob_reader_init(String data);
+internal u32 blob_read_u32(BlobReader *reader);
+internal u64 blob_read_u64(BlobReader *reader);
+internal String blob_read_string(BlobReader *reader);
+
+internal void cache_hash_string(HashState *state, String s);
+internal String cache_file_path(Arena *arena, String name, u64 hash, String extension);
+
+internal u64 cache_stamp_combined(Arena *arena, StringList *paths);
+internal usize cache_env_inputs_size(StringList *names);
+internal void cache_write_env_inputs(Arena *arena, BlobWriter *writer, StringList *names);
+internal b32 cache_read_env_inputs(Arena *arena, BlobReader *reader, StringList *out_names);
+
+internal CacheKey cache_key_create(String project_dir, StringList *env_values);
+internal b32 cache_load(Arena *arena, CacheKey *key, Resolution *out);
+internal b32 cache_store(Arena *arena, CacheKey *key, Resolution *resolution);
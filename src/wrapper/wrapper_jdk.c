@@ -0,0 +1,377 @@
+readonly global u32 JDK_INDEX_MAGIC = 0x4B444A4D; // NOTE(cya): "MJDK"
+readonly global u32 JDK_INDEX_FORMAT_VERSION = 1;
+readonly global char *JDK_RELEASE_KEYS[] = {"JAVA_VERSION", "IMPLEMENTOR", "OS_ARCH"};
+
+#define JDK_RELEASE_BUFFER_SIZE kibibytes(4)
+
+#if defined(ARCH_X64)
+readonly global char *JDK_HOST_ARCHS[] = {"x86_64", "amd64", "x64"};
+#elif defined(ARCH_ARM64)
+readonly global char *JDK_HOST_ARCHS[] = {"aarch64", "arm64"};
+#endif
+
+// NOTE(cya): "1.8.0_292" -> 8, "17.0.2" -> 17, "21" -> 21
+u32 jdk_parse_major(String version)
+{
+    String number = string_keep_number(version);
+    if (string_equals(number, string_lit("1")) && version.len > 2 && version.str[1] == '.') {
+        number = string_keep_number(string_cut_leading(version, 2));
+    }
+
+    return (u32)string_parse_u64(number);
+}
+
+// NOTE(cya): numeric, component-wise ("17.0.10" > "17.0.9")
+i32 jdk_version_compare(String a, String b)
+{
+    usize i = 0, j = 0;
+    while (i < a.len || j < b.len) {
+        String num_a = string_keep_number(string_cut_leading(a, i));
+        String num_b = string_keep_number(string_cut_leading(b, j));
+        u64 val_a = string_parse_u64(num_a);
+        u64 val_b = string_parse_u64(num_b);
+        if (val_a != val_b) {
+            return val_a < val_b ? -1 : 1;
+        }
+
+        if (string_is_empty(num_a) || string_is_empty(num_b)) {
+            break;
+        }
+
+        i = (usize)(num_a.str - a.str) + num_a.len;
+        j = (usize)(num_b.str - b.str) + num_b.len;
+    }
+
+    return 0;
+}
+
+// NOTE(cya): `KEY="VALUE"` lines, unquoted values are accepted too
+internal b32 jdk_release_value(String line, String key, String *out)
+{
+    if (line.len <= key.len || line.str[key.len] != '=') {
+        return false;
+    }
+
+    if (!mem_equal(line.str, key.str, key.len)) {
+        return false;
+    }
+
+    String value = string_cut_leading(line, key.len + 1);
+    if (value.len > 0 && value.str[value.len - 1] == '\r') {
+        value.len -= 1;
+    }
+
+    if (value.len >= 2 && value.str[0] == '"' && value.str[value.len - 1] == '"') {
+        value = string_create(&value.str[1], value.len - 2);
+    }
+
+    *out = value;
+    return true;
+}
+
+// NOTE(cya): the keys we want come first, so reading stops long before the
+// (huge) MODULES line in most release files
+internal b32 jdk_entry_read(Arena *arena, String path, JdkEntry *out)
+{
+    String release_path = string_path_append(arena, path, string_lit("release"));
+    u8 buffer[JDK_RELEASE_BUFFER_SIZE];
+    FileStream stream = platform_file_stream_open(arena, release_path, buffer, sizeof(buffer));
+
+    String values[array_len(JDK_RELEASE_KEYS)] = {0};
+    usize found = 0;
+    b32 skip_line = false;
+    String window = platform_file_stream_refill(&stream, 0);
+    while (found < array_len(values)) {
+        usize consumed = 0;
+        StringLineIter lines = string_line_iter(window);
+        String line;
+        while (found < array_len(values) && string_line_next(&lines, &line)) {
+            if (!lines.is_terminated && !stream.eof) {
+                break;
+            }
+
+            for (usize i = 0; i < array_len(values) && !skip_line; i++) {
+                String key = string_from_cstring(JDK_RELEASE_KEYS[i]);
+                String value;
+                if (string_is_empty(values[i]) && jdk_release_value(line, key, &value)) {
+                    values[i] = string_copy(arena, value);
+                    found += 1;
+                }
+            }
+
+            skip_line = false;
+            consumed = lines.pos;
+        }
+
+        if (stream.eof) {
+            break;
+        }
+
+        // NOTE(cya): a line longer than the whole buffer, its tail is skipped
+        if (consumed == 0) {
+            skip_line = true;
+            consumed = window.len;
+        }
+
+        window = platform_file_stream_refill(&stream, consumed);
+    }
+
+    platform_file_stream_close(&stream);
+    if (string_is_empty(values[0])) {
+        return false;
+    }
+
+    *out = (JdkEntry){
+        .major = jdk_parse_major(values[0]),
+        .version = values[0],
+        .implementor = values[1],
+        .arch = values[2],
+        .path = path,
+    };
+    return true;
+}
+
+internal b32 jdk_entry_less(JdkEntry *a, JdkEntry *b)
+{
+    if (a->major != b->major) {
+        return a->major < b->major;
+    }
+
+    return jdk_version_compare(a->version, b->version) > 0;
+}
+
+internal void jdk_inventory_sort(JdkInventory *inventory)
+{
+    // NOTE(cya): insertion sort, a machine has a handful of JDKs at most
+    JdkEntry *entries = inventory->entries;
+    for (usize i = 1; i < inventory->count; i++) {
+        JdkEntry entry = entries[i];
+        usize j = i;
+        for (; j > 0 && jdk_entry_less(&entry, &entries[j - 1]); j--) {
+            entries[j] = entries[j - 1];
+        }
+
+        entries[j] = entry;
+    }
+}
+
+// NOTE(cya): sdkman's `current` and distro alternatives are symlinks, they're
+// deduplicated by where they point once everything has been collected
+internal void jdk_candidates_push(Arena *arena, StringArray *candidates, String path)
+{
+    String resolved = platform_path_resolve(arena, path);
+    if (!string_is_empty(resolved)) {
+        string_array_push(arena, candidates, resolved);
+    }
+}
+
+internal JdkInventory jdk_inventory_scan(Arena *arena, StringList *roots, StringList *homes)
+{
+    StringArray candidates = {0};
+    string_list_foreach(homes, node) {
+        jdk_candidates_push(arena, &candidates, node->str);
+    }
+
+    string_list_foreach(roots, node) {
+        // NOTE(cya): missing roots just come up empty
+        String root = node->str;
+        FileInfo infos[64];
+        usize count;
+        u32 flags = FILE_ITER_SKIP_HIDDEN | FILE_ITER_SKIP_FILES;
+        FileIter iter = platform_file_iter_begin(arena, root, flags);
+        while ((count = platform_file_iter_next_batch(&iter, infos, array_len(infos)))) {
+            for (usize i = 0; i < count; i++) {
+                String path = string_path_append(arena, root, infos[i].name);
+                jdk_candidates_push(arena, &candidates, path);
+            }
+        }
+
+        platform_file_iter_end(&iter);
+    }
+
+    string_array_dedup(arena, &candidates);
+
+    // NOTE(cya): most children of a root aren't JDKs, their missing `release`
+    // files are found in one batch instead of by failed opens
+    FileStatEntry *releases = arena_push_array(arena, candidates.count, FileStatEntry);
+    for (usize i = 0; i < candidates.count; i++) {
+        String release = string_path_append(arena, candidates.items[i], string_lit("release"));
+        releases[i] = (FileStatEntry){.path = release};
+    }
+
+    platform_file_stat_batch(arena, releases, candidates.count);
+
+    JdkInventory inventory = {
+        .entries = arena_push_array(arena, candidates.count, JdkEntry),
+    };
+    for (usize i = 0; i < candidates.count; i++) {
+        if (!releases[i].exists || releases[i].stat.is_dir) {
+            continue;
+        }
+
+        JdkEntry *entry = &inventory.entries[inventory.count];
+        if (jdk_entry_read(arena, candidates.items[i], entry)) {
+
+            inventory.count += 1;
+        }
+    }
+
+    jdk_inventory_sort(&inventory);
+    return inventory;
+}
+
+// NOTE(cya): roots are stamped by their own mtime (installs add/remove
+// children) and homes by their `release` file (in-place upgrades rewrite it)
+internal u64 jdk_inventory_stamp(Arena *arena, StringList *roots, StringList *homes)
+{
+    StringList stamp_paths = {0};
+    string_list_foreach(roots, node) {
+        string_list_push_back(arena, &stamp_paths, node->str);
+    }
+
+    string_list_foreach(homes, node) {
+        String release = string_path_append(arena, node->str, string_lit("release"));
+        string_list_push_back(arena, &stamp_paths, release);
+    }
+
+    return cache_stamp_combined(arena, &stamp_paths);
+}
+
+internal b32 jdk_inventory_read(String data, u64 stamp, JdkInventory *inventory, Arena *arena)
+{
+    BlobReader reader = blob_reader_init(data);
+    b32 valid = blob_read_u32(&reader) == JDK_INDEX_MAGIC &&
+        blob_read_u32(&reader) == JDK_INDEX_FORMAT_VERSION &&
+        blob_read_u64(&reader) == stamp;
+    // NOTE(cya): each entry takes at least 20 bytes (its major and four string
+    // lengths), which bounds the count a corrupt file can ask for
+    u32 count = blob_read_u32(&reader);
+    if (!valid || reader.failed || count > data.len / (5 * sizeof(u32))) {
+        return false;
+    }
+
+    JdkInventory result = {.entries = arena_push_array(arena, count, JdkEntry)};
+    for (u32 i = 0; i < count; i++) {
+        JdkEntry *entry = &result.entries[i];
+        entry->major = blob_read_u32(&reader);
+        entry->version = blob_read_string(&reader);
+        entry->implementor = blob_read_string(&reader);
+        entry->arch = blob_read_string(&reader);
+        entry->path = blob_read_string(&reader);
+    }
+
+    if (reader.failed) {
+        return false;
+    }
+
+    result.count = count;
+    *inventory = result;
+    return true;
+}
+
+internal void jdk_inventory_write(Arena *arena, String path, u64 stamp, JdkInventory *inventory)
+{
+    usize size = 2 * sizeof(u32) + sizeof(u64) + sizeof(u32);
+    for (usize i = 0; i < inventory->count; i++) {
+        JdkEntry *entry = &inventory->entries[i];
+        size += 5 * sizeof(u32) + entry->version.len + entry->implementor.len +
+            entry->arch.len + entry->path.len;
+    }
+
+    BlobWriter writer = blob_writer_init(arena, size);
+    blob_write_u32(&writer, JDK_INDEX_MAGIC);
+    blob_write_u32(&writer, JDK_INDEX_FORMAT_VERSION);
+    blob_write_u64(&writer, stamp);
+    blob_write_u32(&writer, (u32)inventory->count);
+    for (usize i = 0; i < inventory->count; i++) {
+        JdkEntry *entry = &inventory->entries[i];
+        blob_write_u32(&writer, entry->major);
+        blob_write_string(&writer, entry->version);
+        blob_write_string(&writer, entry->implementor);
+        blob_write_string(&writer, entry->arch);
+        blob_write_string(&writer, entry->path);
+    }
+
+    String data = blob_writer_result(&writer);
+    b32 stored = !string_is_empty(data) &&
+        platform_dir_create_all(arena, string_path_pop_element(path)) &&
+        platform_file_write_atomic(arena, path, data);
+    if (!stored) {
+        log_debug("unable to write JDK index @ {}", path);
+    }
+}
+
+JdkInventory jdk_inventory_load(Arena *arena, StringList *roots, StringList *homes, b32 use_cache)
+{
+    u64 stamp = jdk_inventory_stamp(arena, roots, homes);
+
+    // NOTE(cya): one index per set of roots (they depend on HOME and the env)
+    HashState roots_hash;
+    hash_state_init(&roots_hash, 0);
+    string_list_foreach(roots, node) {
+        cache_hash_string(&roots_hash, node->str);
+    }
+
+    string_list_foreach(homes, node) {
+        cache_hash_string(&roots_hash, node->str);
+    }
+
+    u64 hash = hash_digest_64(&roots_hash);
+    String path = cache_file_path(arena, string_lit("jdks"), hash, string_lit(".bin"));
+    JdkInventory inventory = {0};
+    if (use_cache && !string_is_empty(path)) {
+        FileMapping mapping = platform_file_map(arena, path);
+        if (jdk_inventory_read(mapping.data, stamp, &inventory, arena)) {
+            log_debug("using cached JDK index @ {}", path);
+            return inventory;
+        }
+
+        platform_file_unmap(&mapping);
+    }
+
+    inventory = jdk_inventory_scan(arena, roots, homes);
+    log_debug("indexed {u} JDK installation(s)", (u64)inventory.count);
+    if (use_cache && !string_is_empty(path)) {
+        jdk_inventory_write(arena, path, stamp, &inventory);
+    }
+
+    return inventory;
+}
+
+internal b32 jdk_arch_is_native(String arch)
+{
+    if (string_is_empty(arch)) {
+        return true; // NOTE(cya): older release files don't say
+    }
+
+    for (usize i = 0; i < array_len(JDK_HOST_ARCHS); i++) {
+        if (string_equals(arch, string_from_cstring(JDK_HOST_ARCHS[i]))) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// NOTE(cya): the newest native install of the given major version
+JdkEntry *jdk_inventory_find(JdkInventory *inventory, u32 major)
+{
+    usize lo = 0, hi = inventory->count;
+    while (lo < hi) {
+        usize mid = lo + (hi - lo) / 2;
+        if (inventory->entries[mid].major < major) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    for (usize i = lo; i < inventory->count && inventory->entries[i].major == major; i++) {
+        JdkEntry *entry = &inventory->entries[i];
+        if (jdk_arch_is_native(entry->arch)) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
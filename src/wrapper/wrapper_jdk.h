@@ -0,0 +1,25 @@
+// NOTE(cya): one installed JDK, as described by its `release` file
+typedef struct {
+    u32 major;
+    String version;
+    String implementor;
+    String arch;
+    String path;
+} JdkEntry;
+
+// NOTE(cya): sorted by major version, then newest version first
+typedef struct {
+    JdkEntry *entries;
+    usize count;
+} JdkInventory;
+
+internal u32 jdk_parse_major(String version);
+internal i32 jdk_version_compare(String a, String b);
+
+internal JdkInventory jdk_inventory_load(
+    Arena *arena,
+    StringList *roots,
+    StringList *homes,
+    b32 use_cache
+);
+internal JdkEntry *jdk_inventory_find(JdkInventory *inventory, u32 major);
@@ -0,0 +1,529 @@
+#define POM_MAX_DEPTH 64
+#define POM_MAX_NAME 64
+#define POM_STREAM_BUFFER_SIZE kibibytes(16)
+
+readonly global char COMPILER_PLUGIN_ID[] = "maven-compiler-plugin";
+
+// NOTE(cya): tokens don't outlive a stream refill, so anything kept across
+// them is copied: element names into the parser, values into the arena
+typedef struct {
+    Arena *arena;
+    String names[POM_MAX_DEPTH];
+    u8 name_storage[POM_MAX_DEPTH][POM_MAX_NAME];
+    usize depth;
+    b32 is_done; // NOTE(cya): </project> seen, nothing after it matters
+
+    // NOTE(cya): a plugin's artifactId may come after its configuration
+    usize plugin_depth;
+    b32 plugin_is_managed;
+    String plugin_id;
+    PomCompiler plugin;
+} PomParser;
+
+internal inline b32 pom_parser_at(PomParser *parser, usize index, const char *name)
+{
+    return index < parser->depth &&
+        string_equals(parser->names[index], string_from_cstring(name));
+}
+
+internal String *pom_compiler_field(PomCompiler *compiler, String name)
+{
+    if (string_equals(name, string_lit("release"))) {
+        return &compiler->release;
+    } else if (string_equals(name, string_lit("source"))) {
+        return &compiler->source;
+    } else if (string_equals(name, string_lit("target"))) {
+        return &compiler->target;
+    }
+
+    return NULL;
+}
+
+// NOTE(cya): project/build/plugins/plugin or project/build/pluginManagement/plugins/plugin
+internal b32 pom_parser_is_plugin(PomParser *parser, b32 *out_managed)
+{
+    if (!pom_parser_at(parser, 0, "project") || !pom_parser_at(parser, 1, "build")) {
+        return false;
+    }
+
+    usize top = parser->depth - 1;
+    b32 direct = top == 3 && pom_parser_at(parser, 2, "plugins") &&
+        pom_parser_at(parser, 3, "plugin");
+    if (direct) {
+        *out_managed = false;
+        return true;
+    }
+
+    b32 managed = top == 4 && pom_parser_at(parser, 2, "pluginManagement") &&
+        pom_parser_at(parser, 3, "plugins") && pom_parser_at(parser, 4, "plugin");
+    *out_managed = managed;
+    return managed;
+}
+
+internal String *pom_coordinates_field(PomCoordinates *coordinates, String name)
+{
+    if (string_equals(name, string_lit("groupId"))) {
+        return &coordinates->group_id;
+    } else if (string_equals(name, string_lit("artifactId"))) {
+        return &coordinates->artifact_id;
+    } else if (string_equals(name, string_lit("version"))) {
+        return &coordinates->version;
+    }
+
+    return NULL;
+}
+
+internal inline b32 pom_parser_in_parent(PomParser *parser)
+{
+    return parser->depth == 3 && pom_parser_at(parser, 0, "project") &&
+        pom_parser_at(parser, 1, "parent");
+}
+
+// NOTE(cya): longer names are truncated, none of the ones we look for are
+internal inline void pom_parser_push_name(PomParser *parser, String name)
+{
+    usize depth = parser->depth++;
+    usize len = min(name.len, POM_MAX_NAME);
+    mem_copy(parser->name_storage[depth], name.str, len);
+    parser->names[depth] = string_create(parser->name_storage[depth], len);
+}
+
+internal void pom_parser_on_open(PomParser *parser, Pom *pom, String name)
+{
+    if (parser->depth == 2 && pom_parser_at(parser, 0, "project") &&
+        string_equals(name, string_lit("parent"))) {
+        pom->has_parent = true;
+        pom->parent_relative_path = string_lit("../pom.xml");
+    }
+
+    // NOTE(cya): `<relativePath/>` disables the local lookup altogether
+    if (pom_parser_in_parent(parser) && string_equals(name, string_lit("relativePath"))) {
+        pom->parent_relative_path = string_lit("");
+    }
+
+    b32 is_dependency = parser->depth == 3 && pom_parser_at(parser, 0, "project") &&
+        pom_parser_at(parser, 1, "dependencies") && string_equals(name, string_lit("dependency"));
+    if (is_dependency) {
+        PomDependency *dependency = arena_push_array(parser->arena, 1, PomDependency);
+        *dependency = (PomDependency){0};
+        sll_queue_push_back(pom->dependencies, pom->last_dependency, dependency);
+    }
+
+    // NOTE(cya): registered on open so that empty properties are defined too
+    b32 is_property = parser->depth == 3 && pom_parser_at(parser, 0, "project") &&
+        pom_parser_at(parser, 1, "properties");
+    if (is_property) {
+        PomProperty *property = arena_push_array(parser->arena, 1, PomProperty);
+        *property = (PomProperty){.key = string_copy(parser->arena, name)};
+        sll_queue_push_back(pom->properties, pom->last_property, property);
+    }
+}
+
+internal String *pom_parser_text_field(PomParser *parser, Pom *pom)
+{
+    usize depth = parser->depth;
+    String name = parser->names[depth - 1];
+    if (depth == 2 && pom_parser_at(parser, 0, "project")) {
+        return pom_coordinates_field(&pom->coordinates, name);
+    }
+
+    if (pom_parser_in_parent(parser)) {
+        String *field = pom_coordinates_field(&pom->parent_coordinates, name);
+        b32 is_relative_path = string_equals(name, string_lit("relativePath"));
+        return field != NULL || !is_relative_path ? field : &pom->parent_relative_path;
+    }
+
+    b32 is_property = depth == 3 && pom_parser_at(parser, 0, "project") &&
+        pom_parser_at(parser, 1, "properties");
+    if (is_property) {
+        return &pom->last_property->value;
+    }
+
+    b32 in_dependency = depth == 4 && pom->last_dependency != NULL &&
+        pom_parser_at(parser, 0, "project") && pom_parser_at(parser, 1, "dependencies") &&
+        pom_parser_at(parser, 2, "dependency");
+    if (in_dependency) {
+        if (string_equals(name, string_lit("groupId"))) {
+            return &pom->last_dependency->group_id;
+        } else if (string_equals(name, string_lit("artifactId"))) {
+            return &pom->last_dependency->artifact_id;
+        }
+
+        return NULL;
+    }
+
+    usize plugin = parser->plugin_depth;
+    if (plugin == 0) {
+        return NULL;
+    }
+
+    if (depth == plugin + 2 && pom_parser_at(parser, plugin + 1, "artifactId")) {
+        return &parser->plugin_id;
+    } else if (depth == plugin + 3 && pom_parser_at(parser, plugin + 1, "configuration")) {
+        return pom_compiler_field(&parser->plugin, name);
+    }
+
+    return NULL;
+}
+
+internal void pom_parser_on_text(PomParser *parser, Pom *pom, String text)
+{
+    String value = string_trim_trailing(string_trim_leading(text));
+    usize depth = parser->depth;
+    if (string_is_empty(value) || depth == 0) {
+        return;
+    }
+
+    b32 is_module = depth == 3 && pom_parser_at(parser, 0, "project") &&
+        pom_parser_at(parser, 1, "modules") && pom_parser_at(parser, 2, "module");
+    if (is_module) {
+        string_list_push_back(parser->arena, &pom->modules, string_copy(parser->arena, value));
+        return;
+    }
+
+    String *field = pom_parser_text_field(parser, pom);
+    if (field != NULL) {
+        *field = string_copy(parser->arena, value);
+    }
+}
+
+internal void pom_parser_on_plugin_end(PomParser *parser, Pom *pom)
+{
+    if (!string_equals(parser->plugin_id, string_lit(COMPILER_PLUGIN_ID))) {
+        return;
+    }
+
+    // NOTE(cya): <plugins> config wins over <pluginManagement> defaults
+    String *fields[] = {&pom->plugin.release, &pom->plugin.source, &pom->plugin.target};
+    String values[] = {parser->plugin.release, parser->plugin.source, parser->plugin.target};
+    for (usize i = 0; i < array_len(fields); i++) {
+        b32 keep = string_is_empty(values[i]) ||
+            (parser->plugin_is_managed && !string_is_empty(*fields[i]));
+        if (!keep) {
+            *fields[i] = values[i];
+        }
+    }
+}
+
+// NOTE(cya): consumes tokens until the scanner runs dry (or needs another
+// window), returns whether the pom is complete
+internal b32 pom_parser_feed(PomParser *parser, Pom *pom, XmlScanner *scanner)
+{
+    XmlToken token;
+    while (!parser->is_done && xml_next(scanner, &token)) {
+        switch (token.kind) {
+        case XML_TOKEN_OPEN: {
+            if (parser->depth == POM_MAX_DEPTH) {
+                return true;
+            }
+
+            pom_parser_push_name(parser, token.name);
+            pom_parser_on_open(parser, pom, token.name);
+
+            b32 managed;
+            if (parser->plugin_depth == 0 && pom_parser_is_plugin(parser, &managed)) {
+                parser->plugin_depth = parser->depth - 1;
+                parser->plugin_is_managed = managed;
+                parser->plugin_id = string_lit("");
+                parser->plugin = (PomCompiler){0};
+            }
+        } break;
+        case XML_TOKEN_CLOSE: {
+            if (parser->depth == 0) {
+                return true;
+            }
+
+            parser->depth -= 1;
+            if (parser->plugin_depth != 0 && parser->depth == parser->plugin_depth) {
+                pom_parser_on_plugin_end(parser, pom);
+                parser->plugin_depth = 0;
+            }
+
+            parser->is_done = parser->depth == 0;
+        } break;
+        case XML_TOKEN_TEXT: {
+            pom_parser_on_text(parser, pom, token.text);
+        } break;
+        case XML_TOKEN_EMPTY: {
+            if (parser->depth < POM_MAX_DEPTH) {
+                pom_parser_push_name(parser, token.name);
+                pom_parser_on_open(parser, pom, token.name);
+                parser->depth -= 1;
+            }
+        } break;
+        }
+    }
+
+    return parser->is_done || !scanner->needs_more;
+}
+
+// NOTE(cya): a single pass over the document, kept values are copied
+Pom pom_parse(Arena *arena, String data)
+{
+    Pom pom = {0};
+    PomParser parser = {.arena = arena};
+    XmlScanner scanner = xml_scanner_init(data);
+    pom_parser_feed(&parser, &pom, &scanner);
+    return pom;
+}
+
+// NOTE(cya): streamed through a fixed buffer, so only what the pom keeps ends
+// up in `arena`; reading stops at </project>
+b32 pom_load(Arena *arena, String path, Pom *out)
+{
+    u8 buffer[POM_STREAM_BUFFER_SIZE];
+    FileStream stream = platform_file_stream_open(arena, path, buffer, sizeof(buffer));
+    if (!platform_file_is_valid(stream.file)) {
+        return false;
+    }
+
+    Pom pom = {0};
+    PomParser parser = {.arena = arena};
+    XmlScanner scanner = {0};
+    xml_scanner_refill(&scanner, platform_file_stream_refill(&stream, 0), !stream.eof);
+    b32 is_complete = pom_parser_feed(&parser, &pom, &scanner);
+    while (!is_complete && scanner.pos > 0) {
+        String window = platform_file_stream_refill(&stream, scanner.pos);
+        xml_scanner_refill(&scanner, window, !stream.eof);
+        is_complete = pom_parser_feed(&parser, &pom, &scanner);
+    }
+
+    platform_file_stream_close(&stream);
+
+    // NOTE(cya): a single token larger than the buffer (huge CDATA blocks)
+    if (!is_complete) {
+        pom = pom_parse(arena, platform_file_read_entire(arena, path));
+    }
+
+    *out = pom;
+    out->path = path;
+    return true;
+}
+
+// NOTE(cya): the major version javac is asked for, same precedence as the
+// compiler plugin (release over target over source, plugin config over
+// properties), or empty if nothing in the pom pins it
+String pom_java_version(Arena *arena, Pom *pom, PropertyTable *properties)
+{
+    String plugin_fields[] = {pom->plugin.release, pom->plugin.target, pom->plugin.source};
+    const char *property_keys[] = {
+        "maven.compiler.release",
+        "maven.compiler.target",
+        "maven.compiler.source",
+    };
+
+    // NOTE(cya): evaluated in order, so later candidates are never interpolated
+    for (usize i = 0; i < 2 * array_len(plugin_fields); i++) {
+        String candidate = i % 2 == 0 ?
+            property_table_interpolate(properties, plugin_fields[i / 2]) :
+            property_table_get(properties, string_from_cstring(property_keys[i / 2]));
+
+        // NOTE(cya): anything left uninterpolated doesn't count as a version
+        candidate = string_trim_trailing(string_trim_leading(candidate));
+        b32 is_number = !string_is_empty(candidate) && char_is_digit(candidate.str[0]);
+        u32 major = is_number ? jdk_parse_major(candidate) : 0;
+        if (major != 0) {
+            return string_from_u64(arena, major);
+        }
+    }
+
+    return string_lit("");
+}
+
+PomCache pom_cache_init(Arena *arena, String repository)
+{
+    return (PomCache){
+        .arena = arena,
+        .repository = repository,
+        .entries = hash_map_init(arena, 0),
+    };
+}
+
+Pom *pom_cache_get(PomCache *cache, String path)
+{
+    Arena *arena = cache->arena;
+    String resolved = platform_path_resolve(arena, path);
+    if (string_is_empty(resolved)) {
+        return NULL;
+    }
+
+    u64 entry;
+    if (hash_map_get(&cache->entries, resolved, &entry)) {
+        return (Pom*)(usize)entry;
+    }
+
+    Pom *pom = arena_push_array(arena, 1, Pom);
+    if (pom_load(arena, resolved, pom)) {
+        string_list_push_back(arena, &cache->loaded, resolved);
+    } else {
+        pom = NULL;
+    }
+
+    hash_map_insert(&cache->entries, resolved, (u64)(usize)pom);
+    return pom;
+}
+
+// NOTE(cya): for poms parsed elsewhere (e.g. on reactor workers), whose path
+// is already resolved
+void pom_cache_put(PomCache *cache, Pom *pom)
+{
+    if (hash_map_insert(&cache->entries, pom->path, (u64)(usize)pom)) {
+        string_list_push_back(cache->arena, &cache->loaded, pom->path);
+    }
+}
+
+// NOTE(cya): children may leave out the groupId they inherit
+inline String pom_group_id(Pom *pom)
+{
+    return string_is_empty(pom->coordinates.group_id) ?
+        pom->parent_coordinates.group_id : pom->coordinates.group_id;
+}
+
+internal b32 pom_matches(Pom *pom, PomCoordinates *coordinates)
+{
+    // NOTE(cya): versions are left out on purpose, ci-friendly `${revision}`
+    // parents only match after interpolation
+    return string_equals(pom->coordinates.artifact_id, coordinates->artifact_id) &&
+        string_equals(pom_group_id(pom), coordinates->group_id);
+}
+
+internal String pom_repository_path(PomCache *cache, PomCoordinates *coordinates)
+{
+    Arena *arena = cache->arena;
+    String group = coordinates->group_id;
+    u8 *group_path = arena_push(arena, group.len);
+    for (usize i = 0; i < group.len; i++) {
+        group_path[i] = group.str[i] == '.' ? PLATFORM_PATH_SEPARATOR[0] : group.str[i];
+    }
+
+    String artifact = coordinates->artifact_id;
+    String version = coordinates->version;
+    String group_dir = string_create(group_path, group.len);
+    String dir = string_path_append(arena, cache->repository, group_dir);
+    dir = string_path_append(arena, dir, artifact);
+    dir = string_path_append(arena, dir, version);
+    return string_path_append(arena, dir, string_fmt(arena, "{}-{}.pom", artifact, version));
+}
+
+// NOTE(cya): a pom showing up where it was looked for has to invalidate
+// whatever was derived without it, so misses are tracked like reads
+void pom_cache_miss(PomCache *cache, String path)
+{
+    if (hash_map_insert(&cache->entries, path, 0)) {
+        string_list_push_back(cache->arena, &cache->missing, path);
+    }
+}
+
+internal inline void pom_cache_parent_miss(PomCache *cache, Pom *pom, String path)
+{
+    string_list_push_back(cache->arena, &pom->parent_misses, path);
+    pom_cache_miss(cache, path);
+}
+
+// NOTE(cya): same lookup order as maven: relativePath on disk first, then the
+// local repository
+Pom *pom_cache_parent(PomCache *cache, Pom *pom)
+{
+    if (pom->parent_resolved || !pom->has_parent) {
+        return pom->parent;
+    }
+
+    Arena *arena = cache->arena;
+    PomCoordinates *coordinates = &pom->parent_coordinates;
+    pom->parent_resolved = true;
+    if (!string_is_empty(pom->parent_relative_path)) {
+        String dir = string_path_pop_element(pom->path);
+        String path = string_path_append(arena, dir, pom->parent_relative_path);
+        if (platform_dir_exists(arena, path)) {
+            path = string_path_append(arena, path, string_lit("pom.xml"));
+        }
+
+        Pom *parent = pom_cache_get(cache, path);
+        if (parent != NULL && pom_matches(parent, coordinates)) {
+            pom->parent = parent;
+            return parent;
+        }
+
+        if (parent == NULL) {
+            pom_cache_parent_miss(cache, pom, path);
+        }
+    }
+
+    b32 has_coordinates = !string_is_empty(coordinates->group_id) &&
+        !string_is_empty(coordinates->artifact_id) && !string_is_empty(coordinates->version);
+    if (has_coordinates && !string_is_empty(cache->repository)) {
+        String path = pom_repository_path(cache, coordinates);
+        pom->parent = pom_cache_get(cache, path);
+        if (pom->parent == NULL) {
+            pom_cache_parent_miss(cache, pom, path);
+        }
+    }
+
+    if (pom->parent == NULL) {
+        log_debug("unable to resolve parent {} of {}", coordinates->artifact_id, pom->path);
+    }
+
+    return pom->parent;
+}
+
+internal void pom_compiler_inherit(PomCompiler *child, PomCompiler *parent)
+{
+    String *fields[] = {&child->release, &child->source, &child->target};
+    String *parent_fields[] = {&parent->release, &parent->source, &parent->target};
+    for (usize i = 0; i < array_len(fields); i++) {
+        if (string_is_empty(*fields[i])) {
+            *fields[i] = *parent_fields[i];
+        }
+    }
+}
+
+// NOTE(cya): the pom with every compiler setting it inherits filled in
+Pom pom_cache_merge_chain(PomCache *cache, Pom *pom)
+{
+    Pom result = *pom;
+    usize depth = 0;
+    for (Pom *parent = pom_cache_parent(cache, pom); parent != NULL;
+            parent = pom_cache_parent(cache, parent)) {
+        // NOTE(cya): guards against (broken) cyclic hierarchies
+        if (++depth > 64) {
+            break;
+        }
+
+        pom_compiler_inherit(&result.plugin, &parent->plugin);
+    }
+
+    return result;
+}
+
+internal void pom_push_project_property(PropertyTable *table, const char *key, String value)
+{
+    if (!string_is_empty(value)) {
+        property_table_insert(table, string_from_cstring(key), value);
+    }
+}
+
+// NOTE(cya): the model maven interpolates against, minus the parts we can't
+// know before java is picked (system properties) or don't care about; callers
+// push command line definitions first so they win over the whole chain
+void pom_cache_push_properties(PomCache *cache, Pom *pom, PropertyTable *table)
+{
+    PomCoordinates *own = &pom->coordinates;
+    PomCoordinates *parent = &pom->parent_coordinates;
+    String version = string_is_empty(own->version) ? parent->version : own->version;
+    pom_push_project_property(table, "project.groupId", pom_group_id(pom));
+    pom_push_project_property(table, "project.artifactId", own->artifact_id);
+    pom_push_project_property(table, "project.version", version);
+    pom_push_project_property(table, "project.basedir", string_path_pop_element(pom->path));
+    pom_push_project_property(table, "project.parent.groupId", parent->group_id);
+    pom_push_project_property(table, "project.parent.artifactId", parent->artifact_id);
+    pom_push_project_property(table, "project.parent.version", parent->version);
+
+    usize depth = 0;
+    for (Pom *cur = pom; cur != NULL && depth < 64; cur = pom_cache_parent(cache, cur)) {
+        for (PomProperty *property = cur->properties; property; property = property->next) {
+            property_table_insert(table, property->key, property->value);
+        }
+
+        depth += 1;
+    }
+}
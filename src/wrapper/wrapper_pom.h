@@ -0,0 +1,66 @@
+// NOTE(cya): raw (uninterpolated) values, empty when absent
+typedef struct {
+    String release;
+    String source;
+    String target;
+} PomCompiler;
+
+typedef struct {
+    String group_id;
+    String artifact_id;
+    String version;
+} PomCoordinates;
+
+typedef struct PomProperty {
+    struct PomProperty *next;
+    String key;
+    String value;
+} PomProperty;
+
+typedef struct PomDependency {
+    struct PomDependency *next;
+    String group_id;
+    String artifact_id;
+} PomDependency;
+
+typedef struct Pom {
+    String path; // NOTE(cya): resolved, also the memoization key
+    PomCoordinates coordinates;
+
+    b32 has_parent;
+    PomCoordinates parent_coordinates;
+    String parent_relative_path; // NOTE(cya): empty means "repository only"
+    b32 parent_resolved;
+    struct Pom *parent;
+    StringList parent_misses; // NOTE(cya): lookup candidates that weren't there
+
+    PomProperty *properties; // NOTE(cya): <properties>, in document order
+    PomProperty *last_property;
+    PomCompiler plugin; // NOTE(cya): maven-compiler-plugin <configuration>
+
+    StringList modules; // NOTE(cya): <modules>, as written (dirs or pom files)
+    PomDependency *dependencies; // NOTE(cya): <dependencies>, not the managed ones
+    PomDependency *last_dependency;
+} Pom;
+
+// NOTE(cya): every pom is parsed at most once, however many children share it
+typedef struct {
+    Arena *arena;
+    String repository; // NOTE(cya): local maven repository root
+    HashMap entries; // NOTE(cya): resolved path -> Pom *, NULL when it failed to load
+    StringList loaded; // NOTE(cya): paths of every pom read so far
+    StringList missing; // NOTE(cya): poms looked for that weren't there (inputs too)
+} PomCache;
+
+internal Pom pom_parse(Arena *arena, String data);
+internal String pom_group_id(Pom *pom);
+internal b32 pom_load(Arena *arena, String path, Pom *out);
+internal String pom_java_version(Arena *arena, Pom *pom, PropertyTable *properties);
+
+internal PomCache pom_cache_init(Arena *arena, String repository);
+internal Pom *pom_cache_get(PomCache *cache, String path);
+internal void pom_cache_put(PomCache *cache, Pom *pom);
+internal void pom_cache_miss(PomCache *cache, String path);
+internal Pom *pom_cache_parent(PomCache *cache, Pom *pom);
+internal Pom pom_cache_merge_chain(PomCache *cache, Pom *pom);
+internal void pom_cache_push_properties(PomCache *cache, Pom *pom, PropertyTable *table);
@@ -0,0 +1,165 @@
+#define PROPERTY_MAX_DEPTH 32
+
+readonly global char ENV_PROPERTY_PREFIX[] = "env.";
+
+inline PropertyTable property_table_init(Arena *arena, usize capacity)
+{
+    return (PropertyTable){
+        .arena = arena,
+        .slots = hash_map_init(arena, capacity),
+    };
+}
+
+inline PropertySlot *property_table_find(PropertyTable *table, String key)
+{
+    u64 slot;
+    return hash_map_get(&table->slots, key, &slot) ? (PropertySlot*)(usize)slot : NULL;
+}
+
+// NOTE(cya): first one wins, so layers are pushed from most to least specific
+b32 property_table_insert(PropertyTable *table, String key, String raw)
+{
+    if (string_is_empty(key) || hash_map_find(&table->slots, key) != NULL) {
+        return false;
+    }
+
+    PropertySlot *slot = arena_push_array(table->arena, 1, PropertySlot);
+    *slot = (PropertySlot){
+        .key = key,
+        .raw = raw,
+    };
+    return hash_map_insert(&table->slots, key, (u64)(usize)slot);
+}
+
+internal String property_table_expand(PropertyTable *table, String s, usize depth);
+
+internal String property_table_resolve(PropertyTable *table, String key, usize depth)
+{
+    PropertySlot *slot = property_table_find(table, key);
+    if (slot == NULL) {
+        String prefix = string_lit(ENV_PROPERTY_PREFIX);
+        if (string_starts_with(key, prefix)) {
+            String var = string_cut_leading(key, prefix.len);
+            String value = platform_get_env(table->arena, var);
+            property_table_insert(table, key, value);
+            if (table->env_reads != NULL) {
+                string_list_push_back(table->arena, table->env_reads, var);
+            }
+
+
+            return value;
+        }
+
+        return string_fmt(table->arena, "${{}}", key); // NOTE(cya): left as-is
+    }
+
+    switch (slot->state) {
+    case PROPERTY_RESOLVED: {
+        return slot->value;
+    }
+    case PROPERTY_RESOLVING: {
+        log_warn("cyclic property reference through ${{}}", key);
+        return string_lit("");
+    }
+    case PROPERTY_UNRESOLVED: break;
+    }
+
+    slot->state = PROPERTY_RESOLVING;
+    String value = property_table_expand(table, slot->raw, depth + 1);
+    slot->value = value;
+    slot->state = PROPERTY_RESOLVED;
+    return value;
+}
+
+internal String property_table_expand(PropertyTable *table, String s, usize depth)
+{
+    if (depth > PROPERTY_MAX_DEPTH) {
+        return s;
+    }
+
+    StringList parts = {0};
+    usize cur = 0, i = 0;
+    while (i + 1 < s.len) {
+        if (s.str[i] != '$' || s.str[i + 1] != '{') {
+            i += 1;
+            continue;
+        }
+
+        usize end = i + 2;
+        for (; end < s.len && s.str[end] != '}'; end++) {}
+
+        if (end == s.len) {
+            break;
+        }
+
+        String key = string_create(&s.str[i + 2], end - i - 2);
+        string_list_push_back(table->arena, &parts, string_create(&s.str[cur], i - cur));
+        string_list_push_back(table->arena, &parts, property_table_resolve(table, key, depth));
+        i = cur = end + 1;
+    }
+
+    if (parts.node_count == 0) {
+        return s;
+    }
+
+    string_list_push_back(table->arena, &parts, string_create(&s.str[cur], s.len - cur));
+    return string_list_join(table->arena, &parts, string_lit(""));
+}
+
+String property_table_get(PropertyTable *table, String key)
+{
+    return property_table_find(table, key) == NULL ? string_lit("") :
+        property_table_resolve(table, key, 0);
+}
+
+inline String property_table_interpolate(PropertyTable *table, String s)
+{
+    return property_table_expand(table, s, 0);
+}
+
+// NOTE(cya): the `key[=value]` parts of `-Dkey=value` and `-D key=value`
+StringList property_cli_definitions(Arena *arena, StringList *arguments)
+{
+    StringList result = {0};
+    String flag = string_lit("-D");
+    b32 is_separate = false;
+    string_list_foreach(arguments, node) {
+        String argument = node->str;
+        if (is_separate) {
+            string_list_push_back(arena, &result, argument);
+            is_separate = false;
+        } else if (string_starts_with(argument, flag)) {
+            String definition = string_cut_leading(argument, flag.len);
+            if (string_is_empty(definition)) {
+                is_separate = true;
+            } else {
+                string_list_push_back(arena, &result, definition);
+            }
+        }
+    }
+
+    return result;
+}
+
+// NOTE(cya): bare `-Dflag` definitions are set to "true"
+void property_table_push_cli(PropertyTable *table, StringList *arguments)
+{
+    StringList definitions = property_cli_definitions(table->arena, arguments);
+    string_list_foreach(&definitions, node) {
+        String definition = node->str;
+        usize eq = 0;
+        for (; eq < definition.len && definition.str[eq] != '='; eq++) {}
+
+        String key = string_create(definition.str, eq);
+        String value = eq == definition.len ? string_lit("true") :
+            string_cut_leading(definition, eq + 1);
+
+        // NOTE(cya): the last definition on the command line wins
+        PropertySlot *slot = property_table_find(table, key);
+        if (slot != NULL) {
+            slot->raw = value;
+        } else {
+            property_table_insert(table, key, value);
+        }
+    }
+}
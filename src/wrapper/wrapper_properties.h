@@ -0,0 +1,30 @@
+typedef enum {
+    PROPERTY_UNRESOLVED,
+    PROPERTY_RESOLVING, // NOTE(cya): on the interpolation stack (cycle guard)
+    PROPERTY_RESOLVED,
+} PropertyState;
+
+typedef struct {
+    String key;
+    String raw;
+    String value; // NOTE(cya): only valid once resolved
+    PropertyState state;
+} PropertySlot;
+
+// NOTE(cya): key -> PropertySlot, each slot is its own arena allocation so
+// pointers to it survive the map growing; values are stored raw and only
+// interpolated when someone asks for them
+typedef struct {
+    Arena *arena;
+    HashMap slots;
+    StringList *env_reads; // NOTE(cya): names of the `env.*` lookups, when set
+} PropertyTable;
+
+
+internal PropertyTable property_table_init(Arena *arena, usize capacity);
+internal PropertySlot *property_table_find(PropertyTable *table, String key);
+internal b32 property_table_insert(PropertyTable *table, String key, String raw);
+internal String property_table_get(PropertyTable *table, String key);
+internal String property_table_interpolate(PropertyTable *table, String s);
+internal StringList property_cli_definitions(Arena *arena, StringList *arguments);
+internal void property_table_push_cli(PropertyTable *table, StringList *arguments);
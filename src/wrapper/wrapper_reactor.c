@@ -0,0 +1,625 @@
+readonly global char REACTOR_INDEX_FILE[] = "wrapper-reactor.idx";
+readonly global u32 REACTOR_INDEX_MAGIC = 0x524E564D; // NOTE(cya): "MVNR"
+readonly global u32 REACTOR_INDEX_FORMAT_VERSION = 3;
+
+typedef struct {
+    ReactorModule *modules;
+    u32 count;
+    HashMap by_path;
+    StringList env_inputs;
+} ReactorIndex;
+
+typedef struct {
+    String path; // NOTE(cya): as written in <modules>, joined to the parent's dir
+    String resolved;
+    u64 stamp;
+    ReactorModule *cached; // NOTE(cya): previous scan's entry, if still fresh
+    Pom *pom; // NOTE(cya): parsed here otherwise
+} ReactorJob;
+
+typedef struct {
+    ReactorJob *jobs;
+    u64 count;
+    u64 next; // NOTE(cya): claimed with an atomic add, no other locking
+    ReactorIndex *index; // NOTE(cya): read-only while the batch runs, NULL to parse all
+} ReactorBatch;
+
+typedef struct {
+    ReactorBatch *batch;
+    Arena arena; // NOTE(cya): a child of the scan's pool
+} ReactorWorker;
+
+typedef enum {
+    REACTOR_MARK_NONE,
+    REACTOR_MARK_VISITING,
+    REACTOR_MARK_DONE,
+} ReactorMark;
+
+// NOTE(cya): string -> module index
+internal inline b32 reactor_map_put(HashMap *map, String key, u32 index)
+{
+    return hash_map_insert(map, key, index);
+}
+
+internal inline b32 reactor_map_get(HashMap *map, String key, u32 *out_index)
+{
+    u64 index;
+    if (!hash_map_get(map, key, &index)) {
+        return false;
+    }
+
+    *out_index = (u32)index;
+    return true;
+}
+
+internal inline String reactor_module_key(Arena *arena, String group_id, String artifact_id)
+{
+    return string_fmt(arena, "{}:{}", group_id, artifact_id);
+}
+
+internal void reactor_job_run(Arena *arena, ReactorIndex *index, ReactorJob *job)
+{
+    String path = job->path;
+    if (platform_dir_exists(arena, path)) {
+        path = string_path_append(arena, path, string_lit("pom.xml"));
+    }
+
+    job->resolved = platform_path_resolve(arena, path);
+    if (string_is_empty(job->resolved)) {
+        return;
+    }
+
+    u32 i;
+    job->stamp = cache_stamp(arena, job->resolved);
+    b32 indexed = index != NULL && reactor_map_get(&index->by_path, job->resolved, &i);
+    if (indexed && index->modules[i].stamp == job->stamp) {
+        job->cached = &index->modules[i];
+        return;
+    }
+
+    Pom *pom = arena_push_array(arena, 1, Pom);
+    if (pom_load(arena, job->resolved, pom)) {
+        job->pom = pom;
+    }
+}
+
+internal void reactor_worker_run(void *data)
+{
+    ReactorWorker *worker = data;
+    ReactorBatch *batch = worker->batch;
+    for (;;) {
+        u64 i = atomic_add_u64(&batch->next, 1);
+        if (i >= batch->count) {
+            break;
+        }
+
+        reactor_job_run(&worker->arena, batch->index, &batch->jobs[i]);
+    }
+}
+
+internal void reactor_batch_run(
+    Arena *arena,
+    ReactorWorker *workers,
+    u32 worker_count,
+    ReactorBatch *batch
+) {
+    Thread threads[REACTOR_MAX_WORKERS];
+    u32 thread_count = (u32)min(worker_count, batch->count);
+    for (u32 i = 1; i < thread_count; i++) {
+        workers[i].batch = batch;
+        threads[i] = platform_thread_start(arena, reactor_worker_run, &workers[i]);
+    }
+
+    // NOTE(cya): the calling thread works too, which also covers for any
+    // thread that failed to start
+    workers[0].batch = batch;
+    reactor_worker_run(&workers[0]);
+    for (u32 i = 1; i < thread_count; i++) {
+        platform_thread_join(threads[i]);
+    }
+}
+
+internal u64 reactor_fingerprint(Arena *arena, PomCache *cache, Pom *root, StringList *arguments)
+{
+    HashState state;
+    hash_state_init(&state, 0);
+    cache_hash_string(&state, root->path);
+    cache_hash_string(&state, cache->repository);
+
+    // NOTE(cya): `-D` definitions take part in every module's model
+    StringList definitions = property_cli_definitions(arena, arguments);
+    string_list_foreach(&definitions, node) {
+        cache_hash_string(&state, node->str);
+    }
+
+    return hash_digest_64(&state);
+}
+
+// NOTE(cya): next to the project when it has a `.mvn` dir (maven's own
+// per-project config), in the user cache otherwise; we never create `.mvn`
+// ourselves since maven uses it to find the project's root
+internal String reactor_index_path(Arena *arena, String root_dir)
+{
+    String mvn_dir = string_path_append(arena, root_dir, string_lit(".mvn"));
+    if (platform_dir_exists(arena, mvn_dir)) {
+        return string_path_append(arena, mvn_dir, string_lit(REACTOR_INDEX_FILE));
+    }
+
+    u64 hash = hash_64(root_dir, 0);
+    return cache_file_path(arena, string_lit("reactor"), hash, string_lit(".bin"));
+}
+
+internal void reactor_write_list(BlobWriter *writer, StringList *list)
+{
+    blob_write_u32(writer, (u32)list->node_count);
+    string_list_foreach(list, node) {
+        blob_write_string(writer, node->str);
+    }
+}
+
+internal StringList reactor_read_list(Arena *arena, BlobReader *reader)
+{
+    StringList list = {0};
+    u32 count = blob_read_u32(reader);
+    for (u32 i = 0; i < count && !reader->failed; i++) {
+        string_list_push_back(arena, &list, blob_read_string(reader));
+    }
+
+    return list;
+}
+
+internal inline usize reactor_list_size(StringList *list)
+{
+    return sizeof(u32) + list->total_len + list->node_count * sizeof(u32);
+}
+
+internal b32 reactor_index_read(Arena *arena, String data, u64 fingerprint, ReactorIndex *index)
+{
+    BlobReader reader = blob_reader_init(data);
+    b32 valid = blob_read_u32(&reader) == REACTOR_INDEX_MAGIC &&
+        blob_read_u32(&reader) == REACTOR_INDEX_FORMAT_VERSION &&
+        blob_read_u64(&reader) == fingerprint;
+    if (!valid || !cache_read_env_inputs(arena, &reader, &index->env_inputs)) {
+        return false;
+    }
+
+    u32 count = blob_read_u32(&reader);
+    if (!valid || reader.failed || count > data.len) {
+        return false;
+    }
+
+    ReactorModule *modules = arena_push_array(arena, count, ReactorModule);
+    for (u32 i = 0; i < count && !reader.failed; i++) {
+        ReactorModule *module = &modules[i];
+        *module = (ReactorModule){0};
+        module->pom_path = blob_read_string(&reader);
+        module->stamp = blob_read_u64(&reader);
+        module->group_id = blob_read_string(&reader);
+        module->artifact_id = blob_read_string(&reader);
+        module->java_version = blob_read_string(&reader);
+        module->modules = reactor_read_list(arena, &reader);
+        module->dependencies = reactor_read_list(arena, &reader);
+        module->chain = reactor_read_list(arena, &reader);
+        module->chain_stamp = blob_read_u64(&reader);
+
+        // NOTE(cya): edges are rebuilt from the dependencies on every scan
+        u32 edge_count = blob_read_u32(&reader);
+        for (u32 j = 0; j < edge_count && !reader.failed; j++) {
+            blob_read_u32(&reader);
+        }
+    }
+
+    if (reader.failed) {
+        return false;
+    }
+
+    hash_map_reserve(&index->by_path, count);
+    for (u32 i = 0; i < count; i++) {
+        reactor_map_put(&index->by_path, modules[i].pom_path, i);
+    }
+
+    index->modules = modules;
+    index->count = count;
+    return true;
+}
+
+// NOTE(cya): the entries' strings point into the mapping, which stays around
+internal ReactorIndex reactor_index_load(Arena *arena, String path, u64 fingerprint)
+{
+    ReactorIndex index = {.by_path = hash_map_init(arena, 0)};
+    if (string_is_empty(path)) {
+        return index;
+    }
+
+    FileMapping mapping = platform_file_map(arena, path);
+    if (!reactor_index_read(arena, mapping.data, fingerprint, &index)) {
+        platform_file_unmap(&mapping);
+        index = (ReactorIndex){.by_path = hash_map_init(arena, 0)};
+    }
+
+    return index;
+}
+
+internal b32 reactor_index_store(Arena *arena, String path, u64 fingerprint, Reactor *reactor)
+{
+    usize size = kibibytes(4) + cache_env_inputs_size(&reactor->env_inputs);
+    for (u32 i = 0; i < reactor->count; i++) {
+        ReactorModule *module = &reactor->modules[i];
+        size += 8 * sizeof(u64) + module->pom_path.len + module->group_id.len +
+            module->artifact_id.len + module->java_version.len +
+            reactor_list_size(&module->modules) + reactor_list_size(&module->dependencies) +
+            reactor_list_size(&module->chain) + module->edge_count * sizeof(u32);
+    }
+
+    BlobWriter writer = blob_writer_init(arena, size);
+    blob_write_u32(&writer, REACTOR_INDEX_MAGIC);
+    blob_write_u32(&writer, REACTOR_INDEX_FORMAT_VERSION);
+    blob_write_u64(&writer, fingerprint);
+    cache_write_env_inputs(arena, &writer, &reactor->env_inputs);
+    blob_write_u32(&writer, reactor->count);
+    for (u32 i = 0; i < reactor->count; i++) {
+        ReactorModule *module = &reactor->modules[i];
+        blob_write_string(&writer, module->pom_path);
+        blob_write_u64(&writer, module->stamp);
+        blob_write_string(&writer, module->group_id);
+        blob_write_string(&writer, module->artifact_id);
+        blob_write_string(&writer, module->java_version);
+        reactor_write_list(&writer, &module->modules);
+        reactor_write_list(&writer, &module->dependencies);
+        reactor_write_list(&writer, &module->chain);
+        blob_write_u64(&writer, module->chain_stamp);
+        blob_write_u32(&writer, module->edge_count);
+        for (u32 j = 0; j < module->edge_count; j++) {
+            blob_write_u32(&writer, module->edges[j]);
+        }
+    }
+
+    String data = blob_writer_result(&writer);
+    if (string_is_empty(data)) {
+        return false;
+    }
+
+    return platform_dir_create_all(arena, string_path_pop_element(path)) &&
+        platform_file_write_atomic(arena, path, data);
+}
+
+// NOTE(cya): module poms were stamped while scanning, only parents outside
+// the reactor need another stat
+internal u64 reactor_chain_stamp(Arena *arena, Reactor *reactor, HashMap *by_path, StringList *chain)
+{
+    HashState state;
+    hash_state_init(&state, 0);
+    string_list_foreach(chain, node) {
+        u32 i;
+        b32 is_module = reactor_map_get(by_path, node->str, &i);
+        hash_update_u64(&state, is_module ? reactor->modules[i].stamp : cache_stamp(arena, node->str));
+    }
+
+    return hash_digest_64(&state);
+}
+
+// NOTE(cya): the parts of the effective model we care about; needs the whole
+// parent chain, so this runs on the calling thread against the shared cache
+internal void reactor_module_build(
+    Arena *arena,
+    PomCache *cache,
+    StringList *arguments,
+    StringList *env_reads,
+    ReactorModule *module
+) {
+    Pom *pom = module->pom;
+    PropertyTable properties = property_table_init(arena, 64);
+    properties.env_reads = env_reads;
+    property_table_push_cli(&properties, arguments);
+    pom_cache_push_properties(cache, pom, &properties);
+
+    Pom merged = pom_cache_merge_chain(cache, pom);
+    module->java_version = pom_java_version(arena, &merged, &properties);
+    module->group_id = property_table_interpolate(&properties, pom_group_id(pom));
+    module->artifact_id = property_table_interpolate(&properties, pom->coordinates.artifact_id);
+
+    module->dependencies = (StringList){0};
+    for (PomDependency *dependency = pom->dependencies; dependency; dependency = dependency->next) {
+        String group_id = property_table_interpolate(&properties, dependency->group_id);
+        String artifact_id = property_table_interpolate(&properties, dependency->artifact_id);
+        String key = reactor_module_key(arena, group_id, artifact_id);
+        string_list_push_back(arena, &module->dependencies, key);
+    }
+
+    module->chain = (StringList){0};
+    usize depth = 0;
+    for (Pom *parent = pom_cache_parent(cache, pom); parent != NULL && depth < 64;
+            parent = pom_cache_parent(cache, parent)) {
+        string_list_push_back(arena, &module->chain, parent->path);
+        depth += 1;
+    }
+
+    // NOTE(cya): misses go last (the first entry is still the direct parent
+    // when there is one), their stamps change once the file shows up
+    Pom *cur = pom;
+    for (usize i = 0; cur != NULL && i <= depth; i++, cur = cur->parent) {
+        string_list_foreach(&cur->parent_misses, node) {
+            string_list_push_back(arena, &module->chain, node->str);
+        }
+    }
+}
+
+internal void reactor_link(Arena *arena, Reactor *reactor, HashMap *by_path)
+{
+    HashMap by_key = hash_map_init(arena, reactor->count);
+    for (u32 i = 0; i < reactor->count; i++) {
+        ReactorModule *module = &reactor->modules[i];
+        String key = reactor_module_key(arena, module->group_id, module->artifact_id);
+        reactor_map_put(&by_key, key, i);
+    }
+
+    for (u32 i = 0; i < reactor->count; i++) {
+        ReactorModule *module = &reactor->modules[i];
+        module->edges = arena_push_array(arena, module->dependencies.node_count + 1, u32);
+        module->edge_count = 0;
+
+        // NOTE(cya): a parent in the reactor is built before its children
+        u32 j;
+        StringNode *parent = module->chain.first;
+        if (parent != NULL && reactor_map_get(by_path, parent->str, &j) && j != i) {
+            module->edges[module->edge_count++] = j;
+        }
+
+        string_list_foreach(&module->dependencies, node) {
+            if (reactor_map_get(&by_key, node->str, &j) && j != i) {
+                module->edges[module->edge_count++] = j;
+            }
+        }
+
+        reactor->edge_count += module->edge_count;
+    }
+}
+
+internal void reactor_visit(Reactor *reactor, u8 *marks, u32 i, u32 *order_len)
+{
+    if (marks[i] == REACTOR_MARK_DONE) {
+        return;
+    }
+
+    ReactorModule *module = &reactor->modules[i];
+    if (marks[i] == REACTOR_MARK_VISITING) {
+        log_warn("module dependency cycle through {}", module->pom_path);
+        return;
+    }
+
+    marks[i] = REACTOR_MARK_VISITING;
+    for (u32 e = 0; e < module->edge_count; e++) {
+        reactor_visit(reactor, marks, module->edges[e], order_len);
+    }
+
+    marks[i] = REACTOR_MARK_DONE;
+    reactor->order[(*order_len)++] = i;
+}
+
+internal void reactor_sort(Arena *arena, Reactor *reactor)
+{
+    u8 *marks = arena_push_array(arena, reactor->count, u8);
+    for (u32 i = 0; i < reactor->count; i++) {
+        marks[i] = REACTOR_MARK_NONE;
+    }
+
+    reactor->order = arena_push_array(arena, reactor->count, u32);
+    u32 order_len = 0;
+    for (u32 i = 0; i < reactor->count; i++) {
+        reactor_visit(reactor, marks, i, &order_len);
+    }
+}
+
+internal void reactor_collect_inputs(Arena *arena, Reactor *reactor, PomCache *cache)
+{
+    usize cap = reactor->count + cache->loaded.node_count + cache->missing.node_count;
+    HashMap seen = hash_map_init(arena, cap);
+    StringList *cached[] = {&cache->loaded, &cache->missing};
+    for (usize i = 0; i < array_len(cached); i++) {
+        string_list_foreach(cached[i], node) {
+            if (hash_map_insert(&seen, node->str, 0)) {
+                string_list_push_back(arena, &reactor->inputs, node->str);
+            }
+        }
+    }
+
+    for (u32 i = 0; i < reactor->count; i++) {
+        ReactorModule *module = &reactor->modules[i];
+        if (hash_map_insert(&seen, module->pom_path, 0)) {
+            string_list_push_back(arena, &reactor->inputs, module->pom_path);
+        }
+
+        string_list_foreach(&module->chain, node) {
+            if (hash_map_insert(&seen, node->str, 0)) {
+                string_list_push_back(arena, &reactor->inputs, node->str);
+            }
+        }
+    }
+}
+
+// NOTE(cya): module poms are found and parsed a <modules> level (wave) at a
+// time on a small worker pool; poms whose stamp matches the previous scan's
+// index aren't read at all, and neither is anything else unless its parent
+// chain changed
+Reactor reactor_scan(
+    Arena *arena,
+    PomCache *cache,
+    Pom *root,
+    StringList *arguments,
+    b32 use_cache
+) {
+    Reactor reactor = {0};
+    u64 fingerprint = reactor_fingerprint(arena, cache, root, arguments);
+    String root_dir = string_path_pop_element(root->path);
+    String index_path = use_cache ? reactor_index_path(arena, root_dir) : string_lit("");
+    ReactorIndex index = reactor_index_load(arena, index_path, fingerprint);
+
+    // NOTE(cya): the modules reused from the index read these, and they still
+    // have the values they were indexed with
+    reactor.env_inputs = index.env_inputs;
+
+    // NOTE(cya): never released, parsed poms point into it
+    ArenaPool *pool = arena_push_array(arena, 1, ArenaPool);
+    *pool = arena_pool_init(REACTOR_POOL_RESERVE, REACTOR_POOL_CHUNK_SIZE, ARENA_NO_RESERVE);
+    if (pool->memory == NULL) {
+        log_warn("unable to start the reactor scan for {}", root->path);
+        return reactor;
+    }
+
+    ReactorWorker workers[REACTOR_MAX_WORKERS] = {0};
+    u32 worker_count = min(platform_get_processor_count(), REACTOR_MAX_WORKERS);
+    for (u32 i = 0; i < worker_count; i++) {
+        workers[i].arena = arena_pool_child(pool);
+    }
+
+    u32 capacity = 64;
+    ReactorModule *modules = arena_push_array(arena, capacity, ReactorModule);
+    HashMap by_path = hash_map_init(arena, capacity);
+    modules[0] = (ReactorModule){
+        .pom_path = root->path,
+        .stamp = cache_stamp(arena, root->path),
+        .modules = root->modules,
+        .pom = root,
+        .is_stale = true,
+    };
+
+    // NOTE(cya): the caller parsed the root already, but its model may still
+    // be reused
+    u32 root_index;
+    b32 indexed = reactor_map_get(&index.by_path, root->path, &root_index);
+    if (indexed && index.modules[root_index].stamp == modules[0].stamp) {
+        modules[0] = index.modules[root_index];
+    }
+
+    reactor_map_put(&by_path, root->path, 0);
+    reactor.count = 1;
+
+    u32 wave_start = 0;
+    while (wave_start < reactor.count) {
+        StringList paths = {0};
+        for (u32 i = wave_start; i < reactor.count; i++) {
+            String dir = string_path_pop_element(modules[i].pom_path);
+            string_list_foreach(&modules[i].modules, node) {
+                string_list_push_back(arena, &paths, string_path_append(arena, dir, node->str));
+            }
+        }
+
+        ReactorBatch batch = {.count = paths.node_count, .index = &index};
+        batch.jobs = arena_push_array(arena, paths.node_count, ReactorJob);
+        usize job_count = 0;
+        string_list_foreach(&paths, node) {
+            batch.jobs[job_count++] = (ReactorJob){.path = node->str};
+        }
+
+        wave_start = reactor.count;
+        if (batch.count > 0) {
+            reactor_batch_run(arena, workers, worker_count, &batch);
+        }
+
+        for (usize i = 0; i < job_count; i++) {
+            ReactorJob *job = &batch.jobs[i];
+            if (job->cached == NULL && job->pom == NULL) {
+                log_warn("unable to read reactor module {}", job->path);
+                continue;
+            }
+
+            // NOTE(cya): listed twice (or by two aggregators)
+            if (!reactor_map_put(&by_path, job->resolved, reactor.count)) {
+                continue;
+            }
+
+            if (reactor.count == capacity) {
+                ReactorModule *grown = arena_push_array(arena, capacity * 2, ReactorModule);
+                mem_copy(grown, modules, capacity * sizeof(ReactorModule));
+                modules = grown;
+                capacity *= 2;
+            }
+
+            ReactorModule *module = &modules[reactor.count++];
+            if (job->cached != NULL) {
+                *module = *job->cached;
+                continue;
+            }
+
+            *module = (ReactorModule){
+                .pom_path = job->resolved,
+                .stamp = job->stamp,
+                .modules = job->pom->modules,
+                .pom = job->pom,
+                .is_stale = true,
+            };
+            pom_cache_put(cache, job->pom);
+            reactor.parsed += 1;
+        }
+    }
+
+    // NOTE(cya): unchanged poms whose parents did change get re-read (on the
+    // pool again, a changed root pom makes that every one of them)
+    reactor.modules = modules;
+    u32 reread_count = 0;
+    for (u32 i = 0; i < reactor.count; i++) {
+        ReactorModule *module = &modules[i];
+        if (!module->is_stale) {
+            u64 chain_stamp = reactor_chain_stamp(arena, &reactor, &by_path, &module->chain);
+            module->is_stale = chain_stamp != module->chain_stamp;
+            reread_count += module->is_stale && module->pom == NULL;
+        }
+    }
+
+    ReactorBatch reread = {.count = reread_count};
+    reread.jobs = arena_push_array(arena, reread_count, ReactorJob);
+    for (u32 i = 0, j = 0; i < reactor.count; i++) {
+        if (modules[i].is_stale && modules[i].pom == NULL) {
+            reread.jobs[j++] = (ReactorJob){.path = modules[i].pom_path};
+        }
+    }
+
+    if (reread_count > 0) {
+        reactor_batch_run(arena, workers, worker_count, &reread);
+    }
+
+    b32 changed = reactor.count != index.count;
+    for (u32 i = 0, j = 0; i < reactor.count; i++) {
+        ReactorModule *module = &modules[i];
+        if (!module->is_stale) {
+            continue;
+        }
+
+        if (module->pom == NULL) {
+            module->pom = reread.jobs[j++].pom;
+            if (module->pom == NULL) {
+                log_warn("unable to read reactor module {}", module->pom_path);
+                continue;
+            }
+
+            pom_cache_put(cache, module->pom);
+            reactor.parsed += 1;
+        }
+
+        reactor_module_build(arena, cache, arguments, &reactor.env_inputs, module);
+
+        module->chain_stamp = reactor_chain_stamp(arena, &reactor, &by_path, &module->chain);
+        changed = true;
+    }
+
+    reactor_link(arena, &reactor, &by_path);
+    reactor_sort(arena, &reactor);
+    reactor_collect_inputs(arena, &reactor, cache);
+
+    u64 max_major = 0;
+    for (u32 i = 0; i < reactor.count; i++) {
+        u64 major = string_parse_u64(modules[i].java_version);
+        if (major > max_major) {
+            max_major = major;
+            reactor.java_version = modules[i].java_version;
+            reactor.java_version_pom = modules[i].pom_path;
+        }
+    }
+
+    if (changed && !string_is_empty(index_path) &&
+            !reactor_index_store(arena, index_path, fingerprint, &reactor)) {
+        log_debug("unable to write reactor index for {}", root->path);
+    }
+
+    return reactor;
+}
@@ -0,0 +1,44 @@
+// NOTE(cya): one per pom in the <modules> tree, root first
+typedef struct {
+    String pom_path; // NOTE(cya): resolved
+    u64 stamp;
+    String group_id;
+    String artifact_id;
+    String java_version; // NOTE(cya): effective major, empty when unpinned
+    StringList modules; // NOTE(cya): <modules>, as written
+    StringList dependencies; // NOTE(cya): interpolated "groupId:artifactId"
+    StringList chain; // NOTE(cya): parent poms the model was built from, then misses
+    u64 chain_stamp;
+
+    u32 *edges; // NOTE(cya): in-reactor modules this one depends on
+    u32 edge_count;
+
+    Pom *pom; // NOTE(cya): only set when (re)parsed during this scan
+    b32 is_stale; // NOTE(cya): model has to be rebuilt from `pom`
+} ReactorModule;
+
+typedef struct {
+    ReactorModule *modules;
+    u32 count;
+    u32 edge_count;
+    u32 *order; // NOTE(cya): build order, dependencies before dependents
+    u32 parsed; // NOTE(cya): poms actually read, the rest came from the index
+
+    String java_version; // NOTE(cya): highest level any module asks for
+    String java_version_pom;
+    StringList inputs; // NOTE(cya): every pom the result depends on
+    StringList env_inputs; // NOTE(cya): variables any module read through `${env.*}`
+} Reactor;
+
+
+#define REACTOR_MAX_WORKERS 16
+#define REACTOR_POOL_RESERVE gibibytes(1) // NOTE(cya): address space only
+#define REACTOR_POOL_CHUNK_SIZE mebibytes(1)
+
+internal Reactor reactor_scan(
+    Arena *arena,
+    PomCache *cache,
+    Pom *root,
+    StringList *arguments,
+    b32 use_cache
+);